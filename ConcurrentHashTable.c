@@ -0,0 +1,518 @@
+//
+// Hash table that several threads can use at once: the keys are spread over stripes, each an open-addressing
+// index of immutable entries. Writers lock their key's stripe; readers take no lock at all and rely on
+// epoch-based reclamation (see EpochReclaimer.h) to keep every entry they may still see alive.
+//
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "ConcurrentHashTable.h"
+#include "EpochReclaimer.h"
+
+#define CACHE_LINE_SIZE 64    // Each stripe sits on its own cache line, so stripes never slow each other down
+#define MIN_INDEX_SLOTS 16    // Smallest index a stripe has
+#define REMOVED_ENTRY (&removedEntry) // Marks a slot whose entry was removed; readers probe past it
+
+// Definition of an entry; it is never changed once it is published, only replaced or removed
+typedef struct Concurrent_Entry {
+    uint64_t hash; // The mixed hash of the key
+    Element key;   // The key (owned by the table)
+    Element value; // The value (owned by the table)
+} ConcurrentEntry;
+
+// Definition of a stripe's index: linear probing over entry pointers
+typedef struct Entry_Index {
+    size_t mask;                         // The number of slots minus one (the number of slots is a power of two)
+    size_t used;                         // Slots that are not NULL, removed ones included (writers only)
+    _Atomic(ConcurrentEntry*) slots[];   // NULL, REMOVED_ENTRY or a published entry
+} EntryIndex;
+
+// One stripe: the current index, the lock its writers take and what they retired
+typedef struct Hash_Stripe {
+    _Alignas(CACHE_LINE_SIZE) pthread_mutex_t lock; // Taken by adds and removes; readers never touch it
+    _Atomic(EntryIndex*) index;                     // The current index, swapped whole when the stripe grows
+    atomic_int count;                               // The number of entries in the stripe
+    RetireBatch retired;                            // Entries and indexes readers may still hold (lock held)
+} HashStripe;
+
+// Definition of the Concurrent_Hash_Table structure
+struct Concurrent_Hash_Table {
+    HashStripe* stripes;                             // The stripes, stripeCount of them
+    int stripeCount;                                 // The number of stripes
+    CopyFunction copyKey;                            // Function to copy a key
+    FreeFunction freeKey;                            // Function to free a key
+    CopyFunction copyValue;                          // Function to copy a value
+    FreeFunction freeValue;                          // Function to free a value
+    EqualFunction equalKey;                          // Function to compare keys
+    TransformIntoNumberFunction transformIntoNumber; // Function to hash a key
+};
+
+static ConcurrentEntry removedEntry; // Only its address is used
+
+
+/*
+ * mixedHash:
+ * Returns the key's hash spread over 64 bits (the MurmurHash3 finalizer). The stripe is picked from the high
+ * half and the slot from the low bits, so the two choices do not follow each other.
+ */
+static uint64_t mixedHash(concurrentHashTable table, Element key) {
+    uint64_t hash = (uint32_t)table->transformIntoNumber(key);
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+static HashStripe* stripeOf(concurrentHashTable table, uint64_t hash) {
+    return &table->stripes[((hash >> 32) * (uint64_t)table->stripeCount) >> 32];
+}
+
+
+/*
+ * createIndex:
+ * Returns an empty index with room for at least the given number of entries at half load, or NULL.
+ */
+static EntryIndex* createIndex(size_t entries) {
+    size_t slots = MIN_INDEX_SLOTS;
+    while (slots / 2 < entries) {
+        slots *= 2;
+    }
+    EntryIndex* index = (EntryIndex*)calloc(1, sizeof(EntryIndex) + slots * sizeof(ConcurrentEntry*));
+    if (index) {
+        index->mask = slots - 1;
+    }
+    return index;
+}
+
+
+/*
+ * Reclaim functions, called by the epoch reclaimer once no reader can still hold the memory.
+ * A replaced entry hands its key on to the entry that replaced it, so only its value is freed.
+ */
+static status reclaimIndex(Element index, Element table) {
+    (void)table;
+    free(index);
+    return success;
+}
+
+static status reclaimEntry(Element entry, Element table) {
+    concurrentHashTable owner = (concurrentHashTable)table;
+    owner->freeKey(((ConcurrentEntry*)entry)->key);
+    owner->freeValue(((ConcurrentEntry*)entry)->value);
+    free(entry);
+    return success;
+}
+
+static status reclaimReplacedEntry(Element entry, Element table) {
+    ((concurrentHashTable)table)->freeValue(((ConcurrentEntry*)entry)->value);
+    free(entry);
+    return success;
+}
+
+
+/*
+ * probeIndex:
+ * Returns the published entry of a key, or NULL. Safe without the stripe lock inside a read-side section:
+ * every slot is loaded with acquire, so an entry's fields are seen as they were when it was published.
+ */
+static ConcurrentEntry* probeIndex(concurrentHashTable table, EntryIndex* index, Element key, uint64_t hash) {
+    // The index always keeps some NULL slots, so the probe ends
+    for (size_t i = hash & index->mask;; i = (i + 1) & index->mask) {
+        ConcurrentEntry* entry = atomic_load_explicit(&index->slots[i], memory_order_acquire);
+        if (!entry) {
+            return NULL;
+        }
+        if (entry != REMOVED_ENTRY && entry->hash == hash && table->equalKey(entry->key, key)) {
+            return entry;
+        }
+    }
+}
+
+
+/*
+ * findSlot:
+ * Writer-side search (stripe lock held). Returns the slot holding the key, or -1 if it is absent;
+ * freeSlot receives the first slot on the key's probe where a new entry may go.
+ */
+static long findSlot(concurrentHashTable table, EntryIndex* index, Element key, uint64_t hash, size_t* freeSlot) {
+    bool haveFree = false;
+    for (size_t i = hash & index->mask;; i = (i + 1) & index->mask) {
+        ConcurrentEntry* entry = atomic_load_explicit(&index->slots[i], memory_order_relaxed);
+        if (!haveFree && (!entry || entry == REMOVED_ENTRY)) {
+            *freeSlot = i;
+            haveFree = true;
+        }
+        if (!entry) {
+            return -1;
+        }
+        if (entry != REMOVED_ENTRY && entry->hash == hash && table->equalKey(entry->key, key)) {
+            return (long)i;
+        }
+    }
+}
+
+
+/*
+ * publishEntry:
+ * Stores an entry in a free slot of the current index (stripe lock held). The release store makes the
+ * entry's fields visible to any reader that loads the slot.
+ */
+static void publishEntry(EntryIndex* index, size_t slot, ConcurrentEntry* entry) {
+    if (!atomic_load_explicit(&index->slots[slot], memory_order_relaxed)) {
+        index->used++;
+    }
+    atomic_store_explicit(&index->slots[slot], entry, memory_order_release);
+}
+
+
+/*
+ * makeRoom:
+ * Makes sure the stripe's index can take one more entry and still keep a quarter of its slots NULL
+ * (stripe lock held). Otherwise the live entries are copied into a new index, which is published whole;
+ * readers still probing the old one see a consistent snapshot until they leave their section.
+ */
+static status makeRoom(concurrentHashTable table, HashStripe* stripe) {
+    EntryIndex* index = atomic_load_explicit(&stripe->index, memory_order_relaxed);
+    size_t slots = index->mask + 1;
+    if (index->used + 1 <= slots - slots / 4) {
+        return success;
+    }
+
+    // Size the new index by the live entries only, so removed slots are dropped rather than copied
+    int count = atomic_load_explicit(&stripe->count, memory_order_relaxed);
+    EntryIndex* grown = createIndex((size_t)count + 1);
+    if (!grown) { // Check if memory allocation failed
+        return failure;
+    }
+    for (size_t i = 0; i < slots; i++) {
+        ConcurrentEntry* entry = atomic_load_explicit(&index->slots[i], memory_order_relaxed);
+        if (entry && entry != REMOVED_ENTRY) {
+            size_t slot = entry->hash & grown->mask;
+            while (atomic_load_explicit(&grown->slots[slot], memory_order_relaxed)) {
+                slot = (slot + 1) & grown->mask;
+            }
+            atomic_store_explicit(&grown->slots[slot], entry, memory_order_relaxed);
+        }
+    }
+    grown->used = (size_t)count;
+
+    atomic_store_explicit(&stripe->index, grown, memory_order_release);
+    retireToBatch(stripe->retired, index, reclaimIndex, table);
+    return success;
+}
+
+
+/*
+ * createEntry:
+ * Returns a new entry holding copies of the key and the value, or NULL (nothing is left allocated).
+ */
+static ConcurrentEntry* createEntry(concurrentHashTable table, Element key, Element value, uint64_t hash) {
+    ConcurrentEntry* entry = (ConcurrentEntry*)malloc(sizeof(ConcurrentEntry));
+    if (!entry) {
+        return NULL;
+    }
+    entry->hash = hash;
+    entry->key = table->copyKey(key);
+    entry->value = table->copyValue(value);
+    if (!entry->key || !entry->value) {
+        if (entry->key) {
+            table->freeKey(entry->key);
+        }
+        if (entry->value) {
+            table->freeValue(entry->value);
+        }
+        free(entry);
+        return NULL;
+    }
+    return entry;
+}
+
+
+concurrentHashTable createConcurrentHashTable(CopyFunction copyKey, FreeFunction freeKey,
+                                              CopyFunction copyValue, FreeFunction freeValue,
+                                              EqualFunction equalKey, TransformIntoNumberFunction transformIntoNumber,
+                                              int hashNumber, int stripes) {
+    // Validate the inputs
+    if (!copyKey || !freeKey || !copyValue || !freeValue || !equalKey || !transformIntoNumber ||
+        hashNumber < 1 || stripes < 1 || stripes > MAX_HASH_STRIPES) {
+        return NULL;
+    }
+
+    // Allocate memory for the table and its stripes
+    concurrentHashTable table = (concurrentHashTable)malloc(sizeof(struct Concurrent_Hash_Table));
+    if (!table) { // Check if memory allocation failed
+        return NULL;
+    }
+    table->stripes = (HashStripe*)aligned_alloc(CACHE_LINE_SIZE, (size_t)stripes * sizeof(HashStripe));
+    if (!table->stripes) { // Check if memory allocation failed
+        free(table);
+        return NULL;
+    }
+    table->stripeCount = stripes;
+    table->copyKey = copyKey;
+    table->freeKey = freeKey;
+    table->copyValue = copyValue;
+    table->freeValue = freeValue;
+    table->equalKey = equalKey;
+    table->transformIntoNumber = transformIntoNumber;
+
+    // Give each stripe its share of the expected entries
+    size_t perStripe = (size_t)(hashNumber / stripes + 1);
+    for (int i = 0; i < stripes; i++) {
+        HashStripe* stripe = &table->stripes[i];
+        EntryIndex* index = createIndex(perStripe);
+        RetireBatch retired = createRetireBatch();
+        if (!index || !retired || pthread_mutex_init(&stripe->lock, NULL) != 0) {
+            free(index);
+            destroyRetireBatch(retired);
+            // Undo the stripes created so far
+            while (i-- > 0) {
+                pthread_mutex_destroy(&table->stripes[i].lock);
+                free(atomic_load(&table->stripes[i].index));
+                destroyRetireBatch(table->stripes[i].retired);
+            }
+            free(table->stripes);
+            free(table);
+            return NULL;
+        }
+        atomic_init(&stripe->index, index);
+        atomic_init(&stripe->count, 0);
+        stripe->retired = retired;
+    }
+
+    return table;
+}
+
+
+status destroyConcurrentHashTable(concurrentHashTable table) {
+    // Check if the table is NULL
+    if (!table) {
+        return failure;
+    }
+
+    // Destroy every stripe with its entries
+    for (int i = 0; i < table->stripeCount; i++) {
+        HashStripe* stripe = &table->stripes[i];
+        EntryIndex* index = atomic_load(&stripe->index);
+        for (size_t slot = 0; slot <= index->mask; slot++) {
+            ConcurrentEntry* entry = atomic_load_explicit(&index->slots[slot], memory_order_relaxed);
+            if (entry && entry != REMOVED_ENTRY) {
+                reclaimEntry(entry, table);
+            }
+        }
+        free(index);
+        pthread_mutex_destroy(&stripe->lock);
+
+        // No thread uses the table any more, so what is still waiting for a grace period can go now
+        destroyRetireBatch(stripe->retired);
+    }
+    free(table->stripes);
+    free(table);
+    return success;
+}
+
+
+status addToConcurrentHashTable(concurrentHashTable table, Element key, Element value) {
+    // Validate the inputs
+    if (!table || !key || !value) {
+        return failure;
+    }
+
+    // Only the key's stripe is locked
+    uint64_t hash = mixedHash(table, key);
+    HashStripe* stripe = stripeOf(table, hash);
+    pthread_mutex_lock(&stripe->lock);
+    status result = failure;
+    ConcurrentEntry* entry;
+    if (makeRoom(table, stripe) == success && (entry = createEntry(table, key, value, hash)) != NULL) {
+        // The first NULL or removed slot on the key's probe
+        EntryIndex* index = atomic_load_explicit(&stripe->index, memory_order_relaxed);
+        size_t slot = hash & index->mask;
+        ConcurrentEntry* current;
+        while ((current = atomic_load_explicit(&index->slots[slot], memory_order_relaxed)) != NULL &&
+               current != REMOVED_ENTRY) {
+            slot = (slot + 1) & index->mask;
+        }
+        publishEntry(index, slot, entry);
+        atomic_fetch_add_explicit(&stripe->count, 1, memory_order_relaxed);
+        result = success;
+    }
+    pthread_mutex_unlock(&stripe->lock);
+    return result;
+}
+
+
+status insertIfAbsentInConcurrentHashTable(concurrentHashTable table, Element key, Element value, bool* existed) {
+    // Validate the inputs
+    if (!table || !key || !value || !existed) {
+        return failure;
+    }
+
+    // The search and the insert happen under one lock, so two threads cannot both add the key
+    uint64_t hash = mixedHash(table, key);
+    HashStripe* stripe = stripeOf(table, hash);
+    pthread_mutex_lock(&stripe->lock);
+    status result = failure;
+    if (makeRoom(table, stripe) == success) {
+        EntryIndex* index = atomic_load_explicit(&stripe->index, memory_order_relaxed);
+        size_t freeSlot;
+        if (findSlot(table, index, key, hash, &freeSlot) >= 0) {
+            *existed = true;
+            result = success;
+        } else {
+            ConcurrentEntry* entry = createEntry(table, key, value, hash);
+            if (entry) {
+                publishEntry(index, freeSlot, entry);
+                atomic_fetch_add_explicit(&stripe->count, 1, memory_order_relaxed);
+                *existed = false;
+                result = success;
+            }
+        }
+    }
+    pthread_mutex_unlock(&stripe->lock);
+    return result;
+}
+
+
+status upsertConcurrentHashTable(concurrentHashTable table, Element key, Element value, bool* existed) {
+    // Validate the inputs
+    if (!table || !key || !value) {
+        return failure;
+    }
+
+    uint64_t hash = mixedHash(table, key);
+    HashStripe* stripe = stripeOf(table, hash);
+    pthread_mutex_lock(&stripe->lock);
+    status result = failure;
+    if (makeRoom(table, stripe) == success) {
+        EntryIndex* index = atomic_load_explicit(&stripe->index, memory_order_relaxed);
+        size_t freeSlot;
+        long slot = findSlot(table, index, key, hash, &freeSlot);
+        if (slot >= 0) {
+            // Publish a new entry with the same key in place of the old one, which readers may still hold
+            ConcurrentEntry* old = atomic_load_explicit(&index->slots[slot], memory_order_relaxed);
+            ConcurrentEntry* entry = (ConcurrentEntry*)malloc(sizeof(ConcurrentEntry));
+            Element copy = entry ? table->copyValue(value) : NULL;
+            if (copy) {
+                entry->hash = hash;
+                entry->key = old->key;
+                entry->value = copy;
+                atomic_store_explicit(&index->slots[slot], entry, memory_order_release);
+                retireToBatch(stripe->retired, old, reclaimReplacedEntry, table);
+                result = success;
+            } else {
+                free(entry);
+            }
+        } else {
+            ConcurrentEntry* entry = createEntry(table, key, value, hash);
+            if (entry) {
+                publishEntry(index, freeSlot, entry);
+                atomic_fetch_add_explicit(&stripe->count, 1, memory_order_relaxed);
+                result = success;
+            }
+        }
+        if (result == success && existed) {
+            *existed = slot >= 0;
+        }
+    }
+    pthread_mutex_unlock(&stripe->lock);
+    return result;
+}
+
+
+Element lookupInConcurrentHashTable(concurrentHashTable table, Element key) {
+    // Validate the inputs
+    if (!table || !key) {
+        return NULL;
+    }
+
+    // No lock is taken and nothing shared is written: the reader only announces its epoch in its own slot
+    uint64_t hash = mixedHash(table, key);
+    HashStripe* stripe = stripeOf(table, hash);
+    // The entry may be reclaimed as soon as the section (or the lock) is left, so its value is read inside it
+    ConcurrentEntry* entry;
+    Element value;
+    if (enterEpoch() == success) {
+        entry = probeIndex(table, atomic_load_explicit(&stripe->index, memory_order_acquire), key, hash);
+        value = entry ? entry->value : NULL;
+        exitEpoch();
+    } else {
+        // Every reader slot is taken, so fall back to the writers' lock
+        pthread_mutex_lock(&stripe->lock);
+        entry = probeIndex(table, atomic_load_explicit(&stripe->index, memory_order_relaxed), key, hash);
+        value = entry ? entry->value : NULL;
+        pthread_mutex_unlock(&stripe->lock);
+    }
+    return value;
+}
+
+
+status visitInConcurrentHashTable(concurrentHashTable table, Element key, VisitFunction visit, Element context) {
+    // Validate the inputs
+    if (!table || !key || !visit) {
+        return failure;
+    }
+
+    // The value is not reclaimed before the read-side section ends, even if it is removed or replaced meanwhile
+    uint64_t hash = mixedHash(table, key);
+    HashStripe* stripe = stripeOf(table, hash);
+    status result;
+    if (enterEpoch() == success) {
+        ConcurrentEntry* entry = probeIndex(table, atomic_load_explicit(&stripe->index, memory_order_acquire),
+                                            key, hash);
+        result = entry ? visit(entry->value, context) : failure;
+        exitEpoch();
+    } else {
+        pthread_mutex_lock(&stripe->lock);
+        ConcurrentEntry* entry = probeIndex(table, atomic_load_explicit(&stripe->index, memory_order_relaxed),
+                                            key, hash);
+        result = entry ? visit(entry->value, context) : failure;
+        pthread_mutex_unlock(&stripe->lock);
+    }
+    return result;
+}
+
+
+status removeFromConcurrentHashTable(concurrentHashTable table, Element key) {
+    // Validate the inputs
+    if (!table || !key) {
+        return failure;
+    }
+
+    uint64_t hash = mixedHash(table, key);
+    HashStripe* stripe = stripeOf(table, hash);
+    pthread_mutex_lock(&stripe->lock);
+    EntryIndex* index = atomic_load_explicit(&stripe->index, memory_order_relaxed);
+    size_t freeSlot;
+    long slot = findSlot(table, index, key, hash, &freeSlot);
+    if (slot < 0) {
+        pthread_mutex_unlock(&stripe->lock);
+        return failure;
+    }
+
+    // Unlink the entry, then retire it: readers that already loaded it keep using it until they leave
+    ConcurrentEntry* entry = atomic_load_explicit(&index->slots[slot], memory_order_relaxed);
+    atomic_store_explicit(&index->slots[slot], REMOVED_ENTRY, memory_order_release);
+    atomic_fetch_sub_explicit(&stripe->count, 1, memory_order_relaxed);
+    retireToBatch(stripe->retired, entry, reclaimEntry, table);
+    pthread_mutex_unlock(&stripe->lock);
+    return success;
+}
+
+
+int concurrentHashTableCount(concurrentHashTable table) {
+    // Check if the table is NULL
+    if (!table) {
+        return -1;
+    }
+
+    // Add up the stripes one at a time; concurrent changes may land before or after their stripe is counted
+    int count = 0;
+    for (int i = 0; i < table->stripeCount; i++) {
+        count += atomic_load_explicit(&table->stripes[i].count, memory_order_relaxed);
+    }
+    return count;
+}
@@ -0,0 +1,77 @@
+//
+// Hash table that several threads can use at once: the keys are spread over stripes, each an open-addressing
+// index of immutable entries. Writers lock their key's stripe; readers take no lock at all and rely on
+// epoch-based reclamation (see EpochReclaimer.h) to keep every entry they may still see alive.
+//
+
+#ifndef CONCURRENTHASHTABLE_H
+#define CONCURRENTHASHTABLE_H
+
+#include "Defs.h"
+
+// Most stripes a table can have
+#define MAX_HASH_STRIPES 1024
+
+typedef struct Concurrent_Hash_Table *concurrentHashTable;
+// Defines a pointer to the structure representing the concurrent hash table (opaque pointer).
+
+//
+// Function Prototypes
+//
+// Every function may be called from any number of threads at once, except destroyConcurrentHashTable.
+// Lookups are lock-free: they never write a shared cache line, so they scale with the number of cores.
+// Adds and removes lock only their key's stripe; removed and replaced entries are freed only once no lookup
+// that could have seen them is still running. Each stripe grows on its own, so a resize never stops the others.
+//
+
+// Creates a concurrent hash table.
+// Parameters:
+// - copyKey, freeKey, copyValue, freeValue, equalKey, transformIntoNumber: As for createHashTable.
+// - hashNumber: The number of entries expected (spread over the stripes).
+// - stripes: The number of stripes, from 1 to MAX_HASH_STRIPES; a few times the number of writer threads is typical.
+// Returns the new table or NULL on failure.
+concurrentHashTable createConcurrentHashTable(CopyFunction copyKey, FreeFunction freeKey,
+                                              CopyFunction copyValue, FreeFunction freeValue,
+                                              EqualFunction equalKey, TransformIntoNumberFunction transformIntoNumber,
+                                              int hashNumber, int stripes);
+
+// Destroys the table and every entry in it. No other thread may be using the table.
+// Returns a status code indicating success or failure.
+status destroyConcurrentHashTable(concurrentHashTable table);
+
+// Adds a key-value pair without checking whether the key is already present (like addToHashTable).
+// A lookup of a key added more than once finds one of its values.
+// Returns a status code indicating success or failure.
+status addToConcurrentHashTable(concurrentHashTable table, Element key, Element value);
+
+// Adds a key-value pair unless the key is already present, as one atomic step.
+// Parameters:
+// - existed: Receives true if the key was present (nothing was added), false if the pair was added.
+// Returns a status code indicating success or failure.
+status insertIfAbsentInConcurrentHashTable(concurrentHashTable table, Element key, Element value, bool* existed);
+
+// Adds a key-value pair, or replaces the value of an existing key (like upsertHashTable).
+// Parameters:
+// - existed: May be NULL; otherwise receives whether the key was already present.
+// Returns a status code indicating success or failure.
+status upsertConcurrentHashTable(concurrentHashTable table, Element key, Element value, bool* existed);
+
+// Looks up the value of a key without taking any lock.
+// Another thread may remove or replace the entry right after the call returns; if the table frees its values,
+// use visitInConcurrentHashTable to work with the value while it is guaranteed to exist.
+// Returns the value or NULL if the key is not found.
+Element lookupInConcurrentHashTable(concurrentHashTable table, Element key);
+
+// Looks up the value of a key and calls visit(value, context) while the value is guaranteed not to be freed.
+// visit must not call back into this or any other concurrent table.
+// Returns failure if the key is not found or visit returned failure.
+status visitInConcurrentHashTable(concurrentHashTable table, Element key, VisitFunction visit, Element context);
+
+// Removes a key and its value.
+// Returns a status code indicating success or failure (failure if the key is not found).
+status removeFromConcurrentHashTable(concurrentHashTable table, Element key);
+
+// Returns the number of entries (exact only while no other thread changes the table), or -1 for a NULL table.
+int concurrentHashTableCount(concurrentHashTable table);
+
+#endif // CONCURRENTHASHTABLE_H
@@ -59,6 +59,34 @@
  * returning `true` if they are equal and `false` otherwise.
  */
 
+/*
+ * `typedef int(*CompareFunction) (Element, Element);`:
+ * Function pointer type for functions that order two elements, returning a negative
+ * number if the first comes before the second, 0 if they are equivalent, and a
+ * positive number if the first comes after the second (like `strcmp`).
+ */
+
+/*
+ * `typedef status(*VisitFunction) (Element, Element);`:
+ * Function pointer type for functions called on every element of a container during
+ * a traversal. The second argument is a caller-supplied context pointer; returning
+ * `failure` stops the traversal.
+ */
+
+/*
+ * `typedef status(*AccumulateFunction) (Element, Element, Element);`:
+ * Function pointer type for functions that fold one element (second argument) into a
+ * partial result (first argument) during a reduction. The third argument is a
+ * caller-supplied context pointer.
+ */
+
+/*
+ * `typedef status(*CombineFunction) (Element, Element, Element);`:
+ * Function pointer type for functions that merge the partial result of a later range
+ * (second argument) into the partial result of an earlier one (first argument).
+ * The third argument is a caller-supplied context pointer.
+ */
+
 /*
  * `#endif //DEFS_H`: Closes the include guard, ensuring the header file content
  * is processed only once during compilation.
@@ -78,5 +106,9 @@ typedef status(*FreeFunction) (Element);
 typedef status(*PrintFunction) (Element);
 typedef int(*TransformIntoNumberFunction) (Element);
 typedef bool(*EqualFunction) (Element, Element);
+typedef int(*CompareFunction) (Element, Element);
+typedef status(*VisitFunction) (Element, Element);
+typedef status(*AccumulateFunction) (Element, Element, Element);
+typedef status(*CombineFunction) (Element, Element, Element);
 
 #endif //DEFS_H
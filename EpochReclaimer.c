@@ -0,0 +1,223 @@
+//
+// Epoch-based reclamation: memory that lock-free readers may still be looking at is retired instead of freed,
+// and only reclaimed once every reader that could have seen it has left its read-side section.
+//
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "EpochReclaimer.h"
+
+#define CACHE_LINE_SIZE 64 // Each reader slot sits on its own cache line, so readers never write a shared line
+
+// The epoch a reader announced, on its own cache line
+typedef struct Reader_Slot {
+    _Alignas(CACHE_LINE_SIZE) _Atomic uint64_t epoch; // The global epoch when its section started, 0 outside sections
+    atomic_int claimed;                               // Whether a thread owns the slot
+} ReaderSlot;
+
+#define EPOCH_ADVANCE_INTERVAL 64 // Retires into a batch between two attempts to advance the epoch
+#define FIRST_BATCH_CAPACITY 64   // Items a batch has room for when its first item arrives
+
+// Definition of an item waiting to be reclaimed
+typedef struct Retired_Item {
+    Element item;          // The retired memory
+    VisitFunction reclaim; // Function that frees it
+    Element context;       // Argument handed to reclaim
+    uint64_t epoch;        // The global epoch when it was retired
+} RetiredItem;
+
+// Definition of the Retire_Batch structure
+// A ring of retired items in the order they were retired; the global epoch never goes back, so their epochs
+// never decrease either and the ones whose grace period is over are always at the front
+struct Retire_Batch {
+    RetiredItem* items; // The ring
+    int capacity;       // Items the ring has room for
+    int first;          // Ring position of the oldest item
+    int count;          // Items in the ring
+    int sinceAdvance;   // Retires since the last attempt to advance the epoch
+};
+
+static ReaderSlot readers[MAX_EPOCH_READERS];               // One slot per thread that ever read
+static atomic_int slotsInUse;                               // One past the highest slot ever claimed
+static _Atomic uint64_t globalEpoch = 1;                    // Advances once every active reader has seen it
+
+static _Thread_local int readerSlot = -1;                   // The slot of the calling thread, once it has one
+static pthread_key_t slotKey;                               // Releases a thread's slot when the thread exits
+static pthread_once_t slotKeyOnce = PTHREAD_ONCE_INIT;
+
+
+/*
+ * releaseSlot:
+ * Thread-exit destructor of slotKey: gives the thread's reader slot back.
+ */
+static void releaseSlot(void* slotPlusOne) {
+    atomic_store_explicit(&readers[(intptr_t)slotPlusOne - 1].claimed, 0, memory_order_release);
+}
+
+static void createSlotKey(void) {
+    pthread_key_create(&slotKey, releaseSlot);
+}
+
+
+/*
+ * claimSlot:
+ * Gives the calling thread a reader slot of its own. Returns failure if every slot is taken.
+ */
+static status claimSlot(void) {
+    pthread_once(&slotKeyOnce, createSlotKey);
+    for (int i = 0; i < MAX_EPOCH_READERS; i++) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&readers[i].claimed, &expected, 1)) {
+            readerSlot = i;
+            // Raise the watermark, so epoch advances scan this slot from now on
+            int used = atomic_load(&slotsInUse);
+            while (used < i + 1 && !atomic_compare_exchange_weak(&slotsInUse, &used, i + 1)) {
+            }
+            pthread_setspecific(slotKey, (void*)(intptr_t)(i + 1)); // Non-NULL, so releaseSlot runs at exit
+            return success;
+        }
+    }
+    return failure;
+}
+
+
+status enterEpoch(void) {
+    if (readerSlot < 0 && claimSlot() == failure) {
+        return failure;
+    }
+
+    // Announce the epoch, and make the announcement visible before any pointer of the structure is read
+    atomic_store(&readers[readerSlot].epoch, atomic_load(&globalEpoch));
+    atomic_thread_fence(memory_order_seq_cst);
+    return success;
+}
+
+
+void exitEpoch(void) {
+    if (readerSlot >= 0) {
+        atomic_store_explicit(&readers[readerSlot].epoch, 0, memory_order_release);
+    }
+}
+
+
+/*
+ * tryAdvanceEpoch:
+ * Moves the global epoch forward if every reader inside a section has already announced the current one.
+ * Takes no lock: of several threads advancing from the same epoch at once, only one succeeds.
+ */
+static void tryAdvanceEpoch(void) {
+    uint64_t epoch = atomic_load(&globalEpoch);
+    atomic_thread_fence(memory_order_seq_cst);
+    int used = atomic_load(&slotsInUse);
+    for (int i = 0; i < used; i++) {
+        uint64_t announced = atomic_load(&readers[i].epoch);
+        if (announced != 0 && announced != epoch) {
+            return; // A reader is still in an older epoch
+        }
+    }
+    atomic_compare_exchange_strong(&globalEpoch, &epoch, epoch + 1);
+}
+
+
+/*
+ * reclaimReady:
+ * Reclaims the items at the front of a batch whose grace period is over. Items retired in epoch e are
+ * unreachable for every reader that started in e + 1 or later, so they go once the global epoch reaches e + 2.
+ */
+static void reclaimReady(RetireBatch batch) {
+    uint64_t epoch = atomic_load(&globalEpoch);
+    while (batch->count > 0 && batch->items[batch->first].epoch + 2 <= epoch) {
+        RetiredItem* oldest = &batch->items[batch->first];
+        oldest->reclaim(oldest->item, oldest->context);
+        batch->first = (batch->first + 1) % batch->capacity;
+        batch->count--;
+    }
+}
+
+
+/*
+ * growBatch:
+ * Doubles the ring of a full batch, unwrapping its items to the start of the new one. Returns failure if
+ * memory allocation failed (the batch stays as it was).
+ */
+static status growBatch(RetireBatch batch) {
+    int capacity = batch->capacity ? batch->capacity * 2 : FIRST_BATCH_CAPACITY;
+    RetiredItem* items = (RetiredItem*)malloc((size_t)capacity * sizeof(RetiredItem));
+    if (!items) { // Check if memory allocation failed
+        return failure;
+    }
+    for (int i = 0; i < batch->count; i++) {
+        items[i] = batch->items[(batch->first + i) % batch->capacity];
+    }
+    free(batch->items);
+    batch->items = items;
+    batch->capacity = capacity;
+    batch->first = 0;
+    return success;
+}
+
+
+RetireBatch createRetireBatch(void) {
+    // The ring itself is only allocated when the first item is retired
+    RetireBatch batch = (RetireBatch)malloc(sizeof(struct Retire_Batch));
+    if (!batch) { // Check if memory allocation failed
+        return NULL;
+    }
+    batch->items = NULL;
+    batch->capacity = 0;
+    batch->first = 0;
+    batch->count = 0;
+    batch->sinceAdvance = 0;
+    return batch;
+}
+
+
+status destroyRetireBatch(RetireBatch batch) {
+    // Check if the batch is NULL
+    if (!batch) {
+        return failure;
+    }
+
+    // No reader can reach the items any more, so they go without waiting
+    for (; batch->count > 0; batch->count--) {
+        RetiredItem* oldest = &batch->items[batch->first];
+        oldest->reclaim(oldest->item, oldest->context);
+        batch->first = (batch->first + 1) % batch->capacity;
+    }
+    free(batch->items);
+    free(batch);
+    return success;
+}
+
+
+status retireToBatch(RetireBatch batch, Element item, VisitFunction reclaim, Element context) {
+    // Validate the inputs
+    if (!batch || !item || !reclaim) {
+        return failure;
+    }
+
+    // Scanning the reader slots costs the same however many items wait, so it is only done every few retires
+    if (++batch->sinceAdvance >= EPOCH_ADVANCE_INTERVAL) {
+        batch->sinceAdvance = 0;
+        tryAdvanceEpoch();
+    }
+    reclaimReady(batch);
+
+    if (batch->count == batch->capacity && growBatch(batch) == failure) {
+        // Without memory to queue it, wait until no reader can hold the item any more
+        uint64_t target = atomic_load(&globalEpoch) + 2;
+        while (atomic_load(&globalEpoch) < target) {
+            tryAdvanceEpoch();
+        }
+        reclaim(item, context);
+        return success;
+    }
+    RetiredItem* newest = &batch->items[(batch->first + batch->count) % batch->capacity];
+    newest->item = item;
+    newest->reclaim = reclaim;
+    newest->context = context;
+    newest->epoch = atomic_load(&globalEpoch);
+    batch->count++;
+    return success;
+}
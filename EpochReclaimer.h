@@ -0,0 +1,45 @@
+//
+// Epoch-based reclamation: memory that lock-free readers may still be looking at is retired instead of freed,
+// and only reclaimed once every reader that could have seen it has left its read-side section.
+//
+
+#ifndef EPOCHRECLAIMER_H
+#define EPOCHRECLAIMER_H
+#include "Defs.h"
+
+// Most threads that can be inside a read-side section at the same time; enterEpoch fails for any others
+#define MAX_EPOCH_READERS 256
+
+// Function to start a read-side section on the calling thread
+// Until exitEpoch, nothing retired after the section started is reclaimed; sections must not be nested
+// Returns: failure if MAX_EPOCH_READERS other threads already hold reader slots (the caller should lock instead)
+status enterEpoch(void);
+
+// Function to end the calling thread's read-side section
+void exitEpoch(void);
+
+typedef struct Retire_Batch *RetireBatch; // Defines RetireBatch as a pointer to a Retire_Batch structure
+
+// Function to create an empty batch of retired items
+// Each writer (e.g. each lock-protected part of a structure) keeps a batch of its own, so retiring never
+// takes a lock shared with other writers
+// Returns: The new batch, or NULL if memory allocation failed
+RetireBatch createRetireBatch(void);
+
+// Function to reclaim at once every item still in a batch, then free the batch
+// Only for when no reader can reach those items any more, e.g. while destroying their structure
+// batch: The batch to destroy
+status destroyRetireBatch(RetireBatch batch);
+
+// Function to hand over memory that was just unlinked from a shared structure
+// The item is reclaimed with reclaim(item, context) once no read-side section that started before
+// this call is still running; the caller must make sure no new reader can reach the item any more.
+// Calls on the same batch must not overlap (the caller's own lock usually guarantees it). Each call reclaims
+// the oldest items of the batch whose grace period is over, and tries to advance the epoch every few calls.
+// batch: The batch the item joins
+// item: The memory to reclaim later
+// reclaim: The function that frees it
+// context: An arbitrary pointer handed to reclaim
+status retireToBatch(RetireBatch batch, Element item, VisitFunction reclaim, Element context);
+
+#endif //EPOCHRECLAIMER_H
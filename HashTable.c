@@ -1,63 +1,331 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include "HashTable.h"
-#include "LinkedList.h"
 #include "KeyValuePair.h"
 
+#define GROUP_WIDTH 8                         // Control bytes probed together as one 64-bit word (open backend)
+#define CONTROL_EMPTY ((unsigned char)0x80)   // Control byte of a free slot; a full slot holds the low 7 bits of its hash
+#define CONTROL_MOVED ((unsigned char)0xFE)   // Control byte of a slot of the old storage whose entry already moved or was removed
+#define MAX_LOAD_NUMERATOR 7                  // The open backend grows once it would be more than 7/8 full
+#define MAX_LOAD_DENOMINATOR 8
+#define GROUP_LOW_BITS 0x0101010101010101ULL  // The lowest bit of every control byte in a group
+#define GROUP_HIGH_BITS 0x8080808080808080ULL // The highest bit of every control byte in a group
+#define MIGRATION_STEP 8                      // Old buckets (or groups) moved to the new storage per add or remove while resizing
+#define LOOKUP_BATCH 16                       // Keys lookupManyInHashTable hashes and prefetches before resolving them
+#define FROZEN_BUCKET_LOAD 4                  // Keys per seed bucket of a frozen table, on average
+#define FROZEN_DIRECT 0x80000000u             // Seed flag of a frozen bucket holding one key: the low 31 bits are its slot
+#define FROZEN_MAX_SEED (1u << 22)            // Seeds tried for one frozen bucket before freezing gives up
+#define FILTER_BLOCK_WORDS 8                  // 64-bit words per filter block: one cache line, one bit set in each word
+#define FILTER_BITS_PER_ENTRY 16              // Filter bits per entry at full capacity (well under 1% false positives)
+#define FILTER_MIN_CAPACITY 64                // Fewest entries a filter is sized for
+
+// One slot of the open backend
+typedef struct Open_Slot {
+    Element key;      // The table's copy of the key
+    Element value;    // The table's copy of the value
+    uint64_t hash;    // The mixed hash of the key, so probes and moves never hash the key again
+    bool keyBorrowed; // The key belongs to the caller (HASH_OWNERSHIP_BORROW) and is never freed
+} OpenSlot;
+
+// Slot storage of the open backend
+typedef struct Open_Store {
+    unsigned char* control;   // One control byte per slot: CONTROL_EMPTY, CONTROL_MOVED or the 7-bit hash tag
+    OpenSlot* slots;          // The slots, GROUP_WIDTH per group
+    size_t groupMask;         // Number of groups minus one; the number of groups is a power of two
+    uint64_t* occupied;       // One bit per group, set while the group holds an entry
+} OpenStore;
+
+// Storage of a frozen table: a minimal perfect hash (hash and displace) over the keys
+typedef struct Frozen_Store {
+    uint32_t* seeds;          // One per bucket: the seed that sends its keys to their slots, or FROZEN_DIRECT | slot
+    size_t bucketCount;       // Number of seed buckets
+    OpenSlot* slots;          // One full slot per distinct key hash, so a lookup reads exactly one
+    size_t slotCount;         // Number of slots
+    OpenSlot* twins;          // Entries whose hash equals that of an entry in `slots`, sorted by hash (rare)
+    size_t twinCount;         // Number of twins
+} FrozenStore;
+
+// Blocked Bloom filter over the keys' mixed hashes: a key's bits all lie in one cache-line-sized block
+typedef struct Key_Filter {
+    uint64_t* blocks;         // FILTER_BLOCK_WORDS words per block, aligned to a cache line
+    size_t blockCount;        // Number of blocks
+    int capacity;             // Entries the filter was sized for; it is rebuilt larger past that
+    int stale;                // Entries removed since it was built, whose bits are still set
+} KeyFilter;
+
+// Odd multipliers picking the bit of a key in each word of its block
+static const uint32_t filterSalts[FILTER_BLOCK_WORDS] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
 struct hashTable_s {
     int size;                                  // The number of buckets in the hash table
-    FreeFunction free_key;                    // Function to free the memory of a key
-    FreeFunction free_value;                  // Function to free the memory of a value
-    PrintFunction print_key;                  // Function to print a key
-    PrintFunction print_value;                // Function to print a value
+    KeyValueFunctions functions;              // Functions to free and print keys and values and compare keys,
+                                              // shared by every entry instead of stored in each pair
+    KeyValueFunctions borrowedKeyFunctions;   // The same, except that keys are never freed (creating a pair with a
+                                              // borrowed key; the pair itself then remembers it is borrowed)
     CopyFunction copy_key;                    // Function to copy a key
     CopyFunction copy_value;                  // Function to copy a value
-    EqualFunction equal_key;                  // Function to compare two keys for equality
     EqualFunction equal_value;                // Function to compare two values for equality
     TransformIntoNumberFunction transformIntoNumber; // Function to transform a key into a numeric value (hashing)
-    LinkedList* buckets;                      // Array of linked lists, where each bucket stores key-value pairs
+    HashBackend backend;                      // How the entries are stored
+    KeyValuePair* buckets;                    // Array of buckets, each the first pair of a chain linked through the pairs (chained)
+    uint64_t* occupied;                       // One bit per bucket, set while the bucket is not empty (chained)
+    KeyValuePair* oldBuckets;                 // Buckets being drained into `buckets` while resizing, or NULL (chained)
+    uint64_t* oldOccupied;                    // One bit per old bucket, like `occupied` (chained)
+    int oldSize;                              // The number of old buckets (chained)
+    OpenStore open;                           // The slots entries are added to (open)
+    OpenStore oldOpen;                        // Slots being drained into `open` while resizing; control is NULL otherwise (open)
+    FrozenStore* frozen;                      // Where the entries live once the table is frozen, NULL before (any backend)
+    KeyFilter* filter;                        // Filter answering most lookups of absent keys, NULL unless enabled
+    unsigned long keyCompares;                // Key compares made so far; a sampled lookup's share is the difference
+    int samplePeriod;                         // Every samplePeriod-th lookup is sampled for the statistics, none if 0
+    int sampleTick;                           // Lookups since the last sampled one
+    unsigned long sampledHits;                // Sampled lookups that found their key
+    unsigned long sampledMisses;              // Sampled lookups that did not
+    unsigned long hitCompares;                // Key compares of the sampled hits
+    unsigned long missCompares;               // Key compares of the sampled misses
+    int migrateIndex;                         // Next old bucket (or group) to move while resizing
+    int minimumSize;                          // Buckets (or groups) the table never shrinks below
+    int count;                                // Number of entries stored
 };
 
-static status freeKeyValuePairWrapper(Element e) {
-    if(!e) return failure;
-    // Cast the generic Element to a KeyValuePair and call destroyKeyValuePair
-    destroyKeyValuePair((KeyValuePair)e);
+/*
+ * keepElement:
+ * Free function of borrowed keys: the caller owns them, so the table leaves them alone.
+ */
+static status keepElement(Element e) {
+    (void)e;
     return success;
 }
 
-static bool compareKeyValuePairWrapper(Element e1, Element e2) {
-    // Cast the first generic Element to a KeyValuePair
-    KeyValuePair p1 = (KeyValuePair)e1;
+/*
+ * keysEqual:
+ * Compares a stored key with a looked-up one using the table's function, counting the compare for the statistics.
+ * Compares are only counted while lookups are sampled, so lookups that change nothing never write to the table.
+ */
+static bool keysEqual(hashTable table, Element stored, Element key) {
+    if (table->samplePeriod != 0) {
+        table->keyCompares++;
+    }
+    return table->functions.compare_key(stored, key);
+}
+
+
+hashTable createHashTable(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey,
+                          CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue,
+                          EqualFunction equalKey, TransformIntoNumberFunction transformIntoNumber,
+                          int hashNumber) {
+    // The classic table chains its entries in per-bucket linked lists
+    return createHashTableWithBackend(copyKey, freeKey, printKey, copyValue, freeValue, printValue,
+                                      equalKey, transformIntoNumber, hashNumber, HASH_BACKEND_CHAINED);
+}
+
+
+/*
+ * createBitmap / setBit / clearBit / testBit:
+ * An occupancy bitmap with one bit per bucket (or group), all clear at first, its updates and its reads.
+ */
+static uint64_t* createBitmap(size_t bits) {
+    return (uint64_t*)calloc((bits + 63) / 64, sizeof(uint64_t));
+}
+
+static void setBit(uint64_t* bitmap, size_t bit) {
+    bitmap[bit / 64] |= 1ULL << (bit % 64);
+}
+
+static void clearBit(uint64_t* bitmap, size_t bit) {
+    bitmap[bit / 64] &= ~(1ULL << (bit % 64));
+}
+
+static bool testBit(const uint64_t* bitmap, size_t bit) {
+    return (bitmap[bit / 64] >> (bit % 64)) & 1 ? true : false;
+}
+
+
+/*
+ * nextSetBit:
+ * Returns the first set bit at or after `from`, or `bits` if there is none.
+ * Scans a whole word at a time, so empty stretches of the table cost one step per 64 buckets (or groups).
+ */
+static size_t nextSetBit(const uint64_t* bitmap, size_t bits, size_t from) {
+    if (from >= bits) {
+        return bits;
+    }
+    size_t word = from / 64;
+    uint64_t remaining = bitmap[word] & (~0ULL << (from % 64)); // Ignore the bits before `from`
+    while (remaining == 0) {
+        if (++word >= (bits + 63) / 64) {
+            return bits;
+        }
+        remaining = bitmap[word];
+    }
+    size_t bit = word * 64 + (size_t)__builtin_ctzll(remaining);
+    return bit < bits ? bit : bits;
+}
+
+
+/*
+ * bucketBytes:
+ * The size of a bucket array of `size` buckets followed by its occupancy bitmap.
+ */
+static size_t bucketBytes(int size) {
+    return (size_t)size * sizeof(KeyValuePair) + ((size_t)size + 63) / 64 * sizeof(uint64_t);
+}
+
+
+/*
+ * initBuckets:
+ * Points `occupied` at the bitmap that follows a zeroed bucket array. Every bucket starts as an empty (NULL) chain;
+ * the pairs link to each other, so a bucket never costs more than its one pointer.
+ */
+static KeyValuePair* initBuckets(KeyValuePair* buckets, int size, uint64_t** occupied) {
+    *occupied = (uint64_t*)(buckets + size);
+    return buckets;
+}
+
+
+/*
+ * createBuckets:
+ * Allocates `size` empty buckets and their occupancy bitmap in one block. Returns NULL if memory allocation failed.
+ */
+static KeyValuePair* createBuckets(int size, uint64_t** occupied) {
+    KeyValuePair* buckets = (KeyValuePair*)calloc(1, bucketBytes(size));
+    if (!buckets) { // Check if memory allocation for buckets failed
+        return NULL;
+    }
+    return initBuckets(buckets, size, occupied);
+}
+
+
+/*
+ * freeBuckets:
+ * Frees a bucket array (with its bitmap), unless it is the one allocated together with the table itself.
+ */
+static void freeBuckets(hashTable table, KeyValuePair* buckets) {
+    if (buckets != (KeyValuePair*)(table + 1)) {
+        free(buckets);
+    }
+}
+
+
+/*
+ * destroyBucket:
+ * Destroys every pair of a bucket's chain, releasing the keys and values with the given functions.
+ */
+static void destroyBucket(KeyValuePair chain, const KeyValueFunctions* functions) {
+    while (chain) {
+        KeyValuePair next = getNextPair(chain); // Save the next pair before destroying this one
+        destroyKeyValuePair(chain, functions);
+        chain = next;
+    }
+}
 
-    // Cast the second generic Element to a KeyValuePair
-    KeyValuePair p2 = (KeyValuePair)e2;
 
-    // Use isEqualKey to compare the key of the first pair with the key of the second pair
-    return isEqualKey(p1, getKey(p2));
+/*
+ * appendToBucket:
+ * Links a pair at the end of a bucket's chain, so entries keep the order they were added in. Never allocates.
+ */
+static void appendToBucket(KeyValuePair* buckets, int index, KeyValuePair pair) {
+    setNextPair(pair, NULL);
+    if (!buckets[index]) {
+        buckets[index] = pair;
+        return;
+    }
+    KeyValuePair last = buckets[index];
+    while (getNextPair(last)) {
+        last = getNextPair(last);
+    }
+    setNextPair(last, pair);
 }
 
 
-static status printKeyValuePairWrapper(Element e) {
-    if(!e) return failure;
-    // Cast the generic Element to a KeyValuePair
-    // Call displayKeyValue to print both the key and value of the pair
-    displayKeyValue((KeyValuePair)e);
+/*
+ * createOpenStore:
+ * Allocates empty control bytes and slots for `groups` groups (a power of two) of an open table.
+ */
+static status createOpenStore(OpenStore* store, size_t groups) {
+    unsigned char* control = (unsigned char*)malloc(groups * GROUP_WIDTH);
+    OpenSlot* slots = (OpenSlot*)malloc(groups * GROUP_WIDTH * sizeof(OpenSlot));
+    uint64_t* occupied = createBitmap(groups);
+    if (!control || !slots || !occupied) { // Check if memory allocation failed
+        free(control);
+        free(slots);
+        free(occupied);
+        return failure;
+    }
+    memset(control, CONTROL_EMPTY, groups * GROUP_WIDTH); // Every slot starts free
+
+    store->control = control;
+    store->slots = slots;
+    store->groupMask = groups - 1;
+    store->occupied = occupied;
     return success;
 }
 
 
-hashTable createHashTable(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey,
-                          CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue,
-                          EqualFunction equalKey, TransformIntoNumberFunction transformIntoNumber,
-                          int hashNumber) {
+/*
+ * releaseOpenSlot:
+ * Frees the key (unless borrowed) and the value of a full slot.
+ */
+static void releaseOpenSlot(hashTable table, OpenSlot* slot) {
+    if (!slot->keyBorrowed) {
+        table->functions.free_key(slot->key);
+    }
+    table->functions.free_value(slot->value);
+}
+
+
+/*
+ * destroyOpenStore:
+ * Frees the key and value of every full slot of an open store, then its arrays.
+ */
+static void destroyOpenStore(hashTable table, OpenStore* store) {
+    size_t slotCount = (store->groupMask + 1) * GROUP_WIDTH;
+    for (size_t i = 0; i < slotCount; i++) {
+        if (store->control[i] < CONTROL_EMPTY) { // Full slots hold a 7-bit tag
+            releaseOpenSlot(table, &store->slots[i]);
+        }
+    }
+    free(store->control);
+    free(store->slots);
+    free(store->occupied);
+    store->control = NULL;
+    store->slots = NULL;
+}
+
+
+/*
+ * groupsFor:
+ * Returns the smallest number of groups (a power of two) that holds `entries` entries below the maximum load.
+ */
+static size_t groupsFor(int entries) {
+    size_t groups = 1;
+    while (groups * GROUP_WIDTH * MAX_LOAD_NUMERATOR < (size_t)(entries > 0 ? entries : 0) * MAX_LOAD_DENOMINATOR) {
+        groups *= 2;
+    }
+    return groups;
+}
+
+
+hashTable createHashTableWithBackend(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey,
+                                     CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue,
+                                     EqualFunction equalKey, TransformIntoNumberFunction transformIntoNumber,
+                                     int hashNumber, HashBackend backend) {
     // Validate input function pointers and hash table size
     if (!copyKey || !freeKey || !printKey || !copyValue || !freeValue || !printValue ||
-        !equalKey || !transformIntoNumber) {
+        !equalKey || !transformIntoNumber || hashNumber < 1) {
         return NULL; // Return NULL if any required function is missing
     }
+    if (backend != HASH_BACKEND_CHAINED && backend != HASH_BACKEND_OPEN) {
+        return NULL; // Return NULL for an unknown backend
+    }
 
-    // Allocate memory for the hash table structure
-    hashTable newTable = (hashTable)malloc(sizeof(*newTable));
+    // Allocate memory for the hash table structure, followed by the (all empty) buckets of a chained table
+    hashTable newTable = (hashTable)calloc(1, sizeof(*newTable) +
+                                              (backend == HASH_BACKEND_CHAINED ? bucketBytes(hashNumber) : 0));
     if (!newTable) { // Check if memory allocation failed
         return NULL; // Return NULL if unable to allocate memory
     }
@@ -65,39 +333,92 @@ hashTable createHashTable(CopyFunction copyKey, FreeFunction freeKey, PrintFunct
     // Initialize the hash table fields
     newTable->size = hashNumber;                       // Set the number of buckets
     newTable->copy_key = copyKey;                      // Assign the key copy function
-    newTable->free_key = freeKey;                      // Assign the key free function
-    newTable->print_key = printKey;                    // Assign the key print function
+    newTable->functions.free_key = freeKey;            // Assign the key free function
+    newTable->functions.print_key = printKey;          // Assign the key print function
     newTable->copy_value = copyValue;                  // Assign the value copy function
-    newTable->free_value = freeValue;                  // Assign the value free function
-    newTable->print_value = printValue;                // Assign the value print function
-    newTable->equal_key = equalKey;                    // Assign the key comparison function
+    newTable->functions.free_value = freeValue;        // Assign the value free function
+    newTable->functions.print_value = printValue;      // Assign the value print function
+    newTable->functions.compare_key = equalKey;        // Assign the key comparison function
+    newTable->borrowedKeyFunctions = newTable->functions;
+    newTable->borrowedKeyFunctions.free_key = keepElement; // Borrowed keys belong to the caller
     newTable->equal_value = NULL;                      // (Optional) Value comparison function, unused here
     newTable->transformIntoNumber = transformIntoNumber; // Assign the hashing function
+    newTable->backend = backend;                       // Remember how the entries are stored
+    newTable->buckets = NULL;
+    newTable->occupied = NULL;
+    newTable->oldBuckets = NULL;                       // Not resizing yet
+    newTable->oldOccupied = NULL;
+    newTable->oldSize = 0;
+    newTable->open.control = NULL;
+    newTable->oldOpen.control = NULL;
+    newTable->frozen = NULL;                           // Not frozen until freezeHashTable
+    newTable->filter = NULL;                           // No filter until enableHashTableFilter
+    newTable->keyCompares = 0;
+    newTable->samplePeriod = 0;                        // No lookup sampling until sampleHashTableLookups
+    newTable->sampleTick = 0;
+    newTable->sampledHits = 0;
+    newTable->sampledMisses = 0;
+    newTable->hitCompares = 0;
+    newTable->missCompares = 0;
+    newTable->migrateIndex = 0;
+    newTable->count = 0;
 
-    // Allocate memory for the buckets (array of LinkedList pointers)
-    newTable->buckets = (LinkedList*)malloc(hashNumber * sizeof(LinkedList));
-    if (!newTable->buckets) { // Check if memory allocation for buckets failed
-        free(newTable);       // Free the hash table structure
-        return NULL;          // Return NULL to indicate failure
-    }
-
-    // Initialize each bucket with a linked list
-    for (int i = 0; i < hashNumber; i++) {
-        newTable->buckets[i] = createLinkedList(freeKeyValuePairWrapper, compareKeyValuePairWrapper, printKeyValuePairWrapper);
-        if (!newTable->buckets[i]) { // Check if LinkedList creation failed
-            destroyHashTable(newTable); // Destroy the hash table and free allocated memory
-            return NULL;                // Return NULL to indicate failure
+    if (backend == HASH_BACKEND_OPEN) {
+        // Start with enough groups to hold hashNumber entries below the maximum load
+        size_t groups = groupsFor(hashNumber);
+        if (createOpenStore(&newTable->open, groups) == failure) {
+            free(newTable);
+            return NULL;
         }
+        newTable->minimumSize = (int)groups;
+        return newTable;
     }
 
+    // The buckets live right after the structure, so creating the table is a single allocation
+    newTable->buckets = initBuckets((KeyValuePair*)(newTable + 1), hashNumber, &newTable->occupied);
+    newTable->minimumSize = hashNumber;
+
     return newTable; // Return the newly created hash table
 }
 
+static uint64_t hashStringFully(Element key); // hashString before it is cut down to an int; defined with it below
+
+/*
+ * mixedHash:
+ * Spreads the bits of transformIntoNumber's result over 64 bits (the murmur3 finalizer), so weak key hashes
+ * (small sums, anagrams) still spread over every bucket; the open backend takes the group from the high bits
+ * and the control tag from the low 7 bits. Tables keyed with hashString use its full 64-bit value instead,
+ * which is already well mixed and not limited to the 31 bits an int result can carry.
+ */
+static uint64_t mixedHash(hashTable table, Element key) {
+    if (table->transformIntoNumber == hashString) {
+        return hashStringFully(key);
+    }
+    uint64_t hash = (uint64_t)(unsigned int)table->transformIntoNumber(key);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+
+/*
+ * reduceToRange:
+ * Maps a 64-bit hash onto [0, range - 1] by multiplying its high 32 bits by the range and keeping the top half
+ * of the product (multiply-shift), so every range works, prime or not.
+ */
+static int reduceToRange(uint64_t hash, int range) {
+    return (int)(((hash >> 32) * (uint64_t)(unsigned int)range) >> 32);
+}
+
+
 /*
  * findIndex:
  * Calculates the index (bucket) in the hash table for a given key.
- * - Uses the provided transformIntoNumber function to hash the key into a numeric value.
- * - Computes the bucket index by taking the modulus of the hash value with the table's size.
+ * - Uses the provided transformIntoNumber function to hash the key into a numeric value, and mixes it (mixedHash).
+ * - Maps the mixed hash onto the table's size with a multiply-shift, which needs no division and no sign fix-up.
  *
  * Parameters:
  * - table: Pointer to the hash table.
@@ -107,178 +428,1502 @@ hashTable createHashTable(CopyFunction copyKey, FreeFunction freeKey, PrintFunct
  * - The index (bucket number) where the key should be located.
  */
 int findIndex(hashTable table, Element key) {
-    // Use the transformIntoNumber function to compute a numeric hash value for the key.
-    int hash = table->transformIntoNumber(key);
+    // Reduce the mixed hash of the key to a bucket in the range [0, table->size - 1].
+    return reduceToRange(mixedHash(table, key), table->size);
+}
+
 
-    // Calculate the bucket index by taking the modulus of the hash value with the table's size.
-    // This ensures the index is within the range [0, table->size - 1].
-    return hash % table->size;
+/*
+ * findOldBucket:
+ * Returns the chain of the old bucket that may still hold a key with this mixed hash while the table resizes,
+ * or NULL if there is none (not resizing, that bucket was already moved, or it is empty).
+ */
+static KeyValuePair findOldBucket(hashTable table, uint64_t hash) {
+    if (table->oldBuckets == NULL) {
+        return NULL;
+    }
+    int index = reduceToRange(hash, table->oldSize);
+    return index >= table->migrateIndex ? table->oldBuckets[index] : NULL;
 }
 
 
+/*
+ * homeGroup / controlTag:
+ * The group a probe for `hash` starts at in an open store, and the tag stored in the control byte of its slot.
+ */
+static size_t homeGroup(const OpenStore* store, uint64_t hash) {
+    return (size_t)(hash >> 7) & store->groupMask;
+}
 
-status destroyHashTable(hashTable table) {
-    // Check if the hash table is NULL
-    if (table == NULL) {
-        return failure; // Return failure if the table is already NULL
-    }
+static unsigned char controlTag(uint64_t hash) {
+    return (unsigned char)(hash & 0x7F);
+}
 
-    // Loop through each bucket in the hash table
-    for (int i = 0; i < table->size; i++) {
-        // Destroy the linked list in each bucket
-        destroyLinkedList(table->buckets[i]);
-    }
 
-    // Free the memory allocated for the buckets array
-    free(table->buckets);
+/*
+ * loadGroup:
+ * Reads the GROUP_WIDTH control bytes of a group as one word, control byte i in bits 8i..8i+7.
+ */
+static uint64_t loadGroup(const OpenStore* store, size_t group) {
+    uint64_t word;
+    memcpy(&word, &store->control[group * GROUP_WIDTH], sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
 
-    // Free the memory allocated for the hash table structure itself
-    free(table);
 
-    // Set the table pointer to NULL to avoid dangling references
-    table = NULL;
+/*
+ * matchTag / matchEmpty / matchFull:
+ * Return a word with the high bit of byte i set for every control byte of the group that holds `tag`
+ * (rarely also a neighbour of a real match; callers compare the keys anyway), that is CONTROL_EMPTY, or that is full.
+ */
+static uint64_t matchTag(uint64_t group, unsigned char tag) {
+    uint64_t difference = group ^ (GROUP_LOW_BITS * tag); // Bytes holding the tag become zero
+    return (difference - GROUP_LOW_BITS) & ~difference & GROUP_HIGH_BITS;
+}
 
-    return success; // Return success to indicate the table was successfully destroyed
+static uint64_t matchEmpty(uint64_t group) {
+    return group & ~(group << 6) & GROUP_HIGH_BITS; // High bit set and bit 1 clear: CONTROL_EMPTY, not CONTROL_MOVED
 }
 
+static uint64_t matchFull(uint64_t group) {
+    return ~group & GROUP_HIGH_BITS;
+}
 
-status addToHashTable(hashTable table, Element key, Element value) {
-    // Validate the inputs
-    if (!table || !key || !value) {
-        return failure; // Return failure if the table, key, or value is NULL
-    }
 
-    /* Create copies of the key and value using the provided copy functions */
-    Element keyCopy = table->copy_key(key); // Create a copy of the key
-    if (!keyCopy) { // Check if key copying failed
-        return failure; // Return failure if unable to copy the key
-    }
+/*
+ * slotInGroup:
+ * Converts the lowest match of a matchTag/matchEmpty/matchFull word into a slot number.
+ */
+static size_t slotInGroup(size_t group, uint64_t match) {
+    return group * GROUP_WIDTH + (size_t)(__builtin_ctzll(match) / 8);
+}
 
-    Element valueCopy = table->copy_value(value); // Create a copy of the value
-    if (!valueCopy) { // Check if value copying failed
-        table->free_key(keyCopy); // Free the key copy to prevent memory leaks
-        return failure; // Return failure if unable to copy the value
-    }
 
-    /* Create a KeyValuePair object to store the key and value */
-    KeyValuePair pair = createKeyValuePair(
-        keyCopy,
-        valueCopy,
-        table->free_key,
-        table->free_value,
-        table->print_key,
-        table->print_value,
-        table->equal_key
-    );
-    if (!pair) { // Check if KeyValuePair creation failed
-        /* If creation fails, free the allocated key and value */
-        table->free_key(keyCopy);
-        table->free_value(valueCopy);
-        return failure; // Return failure if unable to create the KeyValuePair
+/*
+ * findOpenSlot:
+ * Returns the slot holding `key` in an open store, or -1 if it is not there.
+ * Probes one group at a time from the key's home group; a group with a free slot ends the probe,
+ * because nothing that probed past it was ever placed further on (deletions keep it that way).
+ */
+static long findOpenSlot(hashTable table, const OpenStore* store, Element key, uint64_t hash) {
+    size_t group = homeGroup(store, hash);
+    unsigned char tag = controlTag(hash);
+
+    for (size_t probes = 0; probes <= store->groupMask; probes++) {
+        uint64_t word = loadGroup(store, group);
+        for (uint64_t match = matchTag(word, tag); match != 0; match &= match - 1) {
+            size_t slot = slotInGroup(group, match);
+            // Compare the full hashes first; the keys only when those match
+            if (store->slots[slot].hash == hash && keysEqual(table, store->slots[slot].key, key)) {
+                return (long)slot; // Found the key
+            }
+        }
+        if (matchEmpty(word) != 0) {
+            return -1; // The probe ends at the first group with a free slot
+        }
+        group = (group + 1) & store->groupMask; // Move on to the next group
     }
+    return -1;
+}
 
-    /* Calculate the hash index for the key */
-    int hash = findIndex(table, key);
-    /* The hash index determines the bucket where the KeyValuePair will be stored */
 
-    /* Add the KeyValuePair to the appropriate bucket (linked list) */
-    if (appendNode(table->buckets[hash], pair) == failure) { // Check if insertion failed
-        destroyKeyValuePair(pair); // Free the KeyValuePair to prevent memory leaks
-        return failure; // Return failure if unable to append the node
+/*
+ * placeInOpenStore:
+ * Stores an entry in the first free slot along its probe sequence and returns that slot. The store must have a free slot.
+ */
+static size_t placeInOpenStore(OpenStore* store, uint64_t hash, Element key, Element value, bool keyBorrowed) {
+    size_t group = homeGroup(store, hash);
+    uint64_t free_slots;
+    while ((free_slots = matchEmpty(loadGroup(store, group))) == 0) {
+        group = (group + 1) & store->groupMask;
     }
 
-    return success; // Return success to indicate the key-value pair was added
+    size_t slot = slotInGroup(group, free_slots);
+    store->control[slot] = controlTag(hash);
+    store->slots[slot].key = key;
+    store->slots[slot].value = value;
+    store->slots[slot].hash = hash;
+    store->slots[slot].keyBorrowed = keyBorrowed;
+    setBit(store->occupied, group);
+    return slot;
 }
 
-Element lookupInHashTable(hashTable table, Element key) {
-    // Validate the inputs
-    if (!table || !key) {
-        return NULL; // Return NULL if the hash table or key is invalid
+
+/*
+ * updateGroupOccupancy:
+ * Clears the occupancy bit of a group of an open store once no entry is left in it.
+ */
+static void updateGroupOccupancy(OpenStore* store, size_t group) {
+    if (matchFull(loadGroup(store, group)) == 0) {
+        clearBit(store->occupied, group);
     }
+}
+
 
-    // Calculate the hash index for the key
-    int hash = findIndex(table, key);
-    // Ensure the hash value is within the valid range using modulo operation
+/*
+ * removeOpenSlot:
+ * Frees the entry in `hole` of the table's current store and keeps every other entry reachable without tombstones:
+ * if the hole's group was full, a later entry whose probe passed that group moves back into the hole, and the same
+ * is repeated for the slot it left, until a group that already had a free slot is reached.
+ */
+static void removeOpenSlot(hashTable table, size_t hole) {
+    OpenStore* store = &table->open;
+    releaseOpenSlot(table, &store->slots[hole]);
 
-    // Get the linked list (bucket) at the computed hash index
-    LinkedList bucket = table->buckets[hash];
-    if (!bucket) {
-        return NULL; // Return NULL if the bucket does not exist
+    // Probes only continue past full groups, so a hole in a group that had a free slot hides nothing
+    size_t holeGroup = hole / GROUP_WIDTH;
+    bool holeGroupWasFull = matchEmpty(loadGroup(store, holeGroup)) == 0 ? true : false;
+    store->control[hole] = CONTROL_EMPTY;
+    if (!holeGroupWasFull) {
+        updateGroupOccupancy(store, holeGroup);
+        return;
     }
 
-    // Start traversing the bucket to find the key-value pair
-    Element e = getFirstElement(bucket); // Get the first element in the bucket
-    while (e) {
-        // Cast the element to KeyValuePair
-        KeyValuePair p = (KeyValuePair)e;
+    size_t group = holeGroup;
+    while (true) {
+        group = (group + 1) & store->groupMask;
+        uint64_t word = loadGroup(store, group); // The group as it was before any move
+
+        // Look for an entry of this group whose probe went through the hole's group
+        for (uint64_t match = matchFull(word); match != 0; match &= match - 1) {
+            size_t slot = slotInGroup(group, match);
+            size_t home = homeGroup(store, store->slots[slot].hash);
+            if (((holeGroup - home) & store->groupMask) < ((group - home) & store->groupMask)) {
+                // Move it back into the hole; its old slot becomes the new hole
+                store->slots[hole] = store->slots[slot];
+                store->control[hole] = store->control[slot];
+                store->control[slot] = CONTROL_EMPTY;
+                hole = slot;
+                holeGroup = group;
+                break;
+            }
+        }
 
-        // Check if the key in the pair matches the lookup key
-        if (table->equal_key(getKey(p), key)) {
-            return getValue(p); // Return the value if the keys match
+        // A group that had a free slot was never probed past, so nothing further can depend on the hole
+        if (matchEmpty(word) != 0) {
+            updateGroupOccupancy(store, holeGroup); // Only the last hole stays empty
+            return;
         }
+    }
+}
+
+
+/*
+ * frozenPosition:
+ * The slot a key with this mixed hash lands on among `slots` slots when its bucket uses `seed`.
+ * The seed is mixed into the hash again (murmur3 finalizer), so each seed gives an independent placement.
+ */
+static size_t frozenPosition(uint64_t hash, uint32_t seed, size_t slots) {
+    uint64_t mixed = hash ^ ((uint64_t)seed * 0x9e3779b97f4a7c15ULL);
+    mixed ^= mixed >> 33;
+    mixed *= 0xff51afd7ed558ccdULL;
+    mixed ^= mixed >> 33;
+    mixed *= 0xc4ceb9fe1a85ec53ULL;
+    mixed ^= mixed >> 33;
+    return (size_t)reduceToRange(mixed, (int)slots);
+}
 
-        // Move to the next element in the bucket
-        e = getNextElement(bucket, e);
+
+/*
+ * findFrozenSlot:
+ * Returns the slot of a key (whose mixed hash is `hash`) in a frozen table, or NULL.
+ * The key's bucket seed names its one possible slot, so a lookup reads one seed and one slot and compares
+ * one key; only a key whose hash another key shares has to look further, among the twins.
+ */
+static OpenSlot* findFrozenSlot(hashTable table, Element key, uint64_t hash) {
+    const FrozenStore* frozen = table->frozen;
+    if (frozen->slotCount == 0) {
+        return NULL;
+    }
+    uint32_t seed = frozen->seeds[reduceToRange(hash, (int)frozen->bucketCount)];
+    size_t position = (seed & FROZEN_DIRECT) ? (size_t)(seed & ~FROZEN_DIRECT)
+                                             : frozenPosition(hash, seed, frozen->slotCount);
+    OpenSlot* slot = &frozen->slots[position];
+    if (slot->hash != hash) {
+        return NULL; // The slot belongs to another key, so this one is absent
+    }
+    if (keysEqual(table, slot->key, key)) {
+        return slot;
     }
 
-    // Return NULL if the key is not found in the bucket
+    // Same hash, different key: binary search for the run of twins with this hash
+    size_t low = 0, high = frozen->twinCount;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (frozen->twins[middle].hash < hash) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    for (; low < frozen->twinCount && frozen->twins[low].hash == hash; low++) {
+        if (keysEqual(table, frozen->twins[low].key, key)) {
+            return &frozen->twins[low];
+        }
+    }
     return NULL;
 }
 
 
-status removeFromHashTable(hashTable table, Element key) {
-    // Validate the inputs
-    if (!table || !key) {
-        return failure; // Return failure if the hash table or key is invalid
+/*
+ * destroyFrozenStore:
+ * Frees the key and value of every entry of a frozen table, then its storage.
+ */
+static void destroyFrozenStore(hashTable table, FrozenStore* frozen) {
+    for (size_t i = 0; i < frozen->slotCount; i++) {
+        releaseOpenSlot(table, &frozen->slots[i]);
+    }
+    for (size_t i = 0; i < frozen->twinCount; i++) {
+        releaseOpenSlot(table, &frozen->twins[i]);
     }
+    free(frozen->seeds);
+    free(frozen->slots);
+    free(frozen->twins);
+    free(frozen);
+}
+
+
+/*
+ * filterBlock / addToFilter / filterMayContain:
+ * The block of a key with this mixed hash, which the high bits pick, and setting or testing its bits:
+ * one bit in each word of the block, picked from the low 32 bits by the salts.
+ */
+static uint64_t* filterBlock(const KeyFilter* filter, uint64_t hash) {
+    return &filter->blocks[(size_t)reduceToRange(hash, (int)filter->blockCount) * FILTER_BLOCK_WORDS];
+}
+
+static void addToFilter(KeyFilter* filter, uint64_t hash) {
+    uint64_t* block = filterBlock(filter, hash);
+    for (int i = 0; i < FILTER_BLOCK_WORDS; i++) {
+        block[i] |= 1ULL << (((uint32_t)hash * filterSalts[i]) >> 26);
+    }
+}
+
+static bool filterMayContain(const KeyFilter* filter, uint64_t hash) {
+    const uint64_t* block = filterBlock(filter, hash);
+    for (int i = 0; i < FILTER_BLOCK_WORDS; i++) {
+        if (!(block[i] & (1ULL << (((uint32_t)hash * filterSalts[i]) >> 26)))) {
+            return false;
+        }
+    }
+    return true;
+}
 
-    // Calculate the hash index for the key
-    int hash = findIndex(table, key);
-    // Ensure the hash value is within the valid range using modulo operation
 
-    // Get the linked list (bucket) at the computed hash index
-    LinkedList bucket = table->buckets[hash];
-    if (!bucket) {
-        return failure; // Return failure if the bucket does not exist
+/*
+ * destroyKeyFilter:
+ * Frees a filter (NULL is ignored).
+ */
+static void destroyKeyFilter(KeyFilter* filter) {
+    if (filter) {
+        free(filter->blocks);
+        free(filter);
     }
+}
 
-    // Start traversing the bucket to find the key-value pair
-    Element e = getFirstElement(bucket); // Get the first element in the bucket
-    while (e) {
-        // Cast the element to KeyValuePair
-        KeyValuePair p = (KeyValuePair)e;
 
-        // Check if the key in the pair matches the key to be removed
-        if (table->equal_key(getKey(p), key)) {
-            // Remove the node from the linked list
-            if (deleteNode(bucket, e) == failure) {
-                return failure; // Return failure if the deletion operation fails
+/*
+ * migrateEntries:
+ * Moves up to `steps` old buckets (or old groups) into the new storage while the table resizes,
+ * and frees the old storage once it is empty. A negative `steps` finishes the whole move.
+ */
+static void migrateEntries(hashTable table, int steps) {
+    if (table->backend == HASH_BACKEND_OPEN) {
+        OpenStore* old = &table->oldOpen;
+        while (old->control != NULL && steps-- != 0) {
+            // Move every entry of the next old group; CONTROL_MOVED keeps the old probes of the others intact
+            size_t group = (size_t)table->migrateIndex;
+            for (uint64_t match = matchFull(loadGroup(old, group)); match != 0; match &= match - 1) {
+                size_t slot = slotInGroup(group, match);
+                placeInOpenStore(&table->open, old->slots[slot].hash, old->slots[slot].key, old->slots[slot].value,
+                                 old->slots[slot].keyBorrowed);
+                old->control[slot] = CONTROL_MOVED;
+            }
+            clearBit(old->occupied, group);
+
+            if ((size_t)++table->migrateIndex > old->groupMask) {
+                destroyOpenStore(table, old); // Everything moved (removed entries were already freed)
             }
-            return success; // Return success after removing the key-value pair
         }
+        return;
+    }
+
+    while (table->oldBuckets != NULL && steps-- != 0) {
+        // Relink the pairs of the next old bucket into their new buckets, in order; nothing is allocated
+        KeyValuePair pair = table->oldBuckets[table->migrateIndex];
+        while (pair) {
+            KeyValuePair next = getNextPair(pair); // Save the rest of the old chain before relinking the pair
+            int index = reduceToRange(getKeyHash(pair), table->size);
+            appendToBucket(table->buckets, index, pair);
+            setBit(table->occupied, (size_t)index);
+            pair = next;
+        }
+        table->oldBuckets[table->migrateIndex] = NULL;
+        clearBit(table->oldOccupied, (size_t)table->migrateIndex);
 
-        // Move to the next element in the bucket
-        e = getNextElement(bucket, e);
+        if (++table->migrateIndex == table->oldSize) {
+            freeBuckets(table, table->oldBuckets); // Every bucket moved
+            table->oldBuckets = NULL;
+            table->oldOccupied = NULL;
+        }
     }
+}
+
 
-    // Return failure if the key was not found in the bucket
-    return failure;
+/*
+ * isResizing:
+ * Tells whether the table still has old storage to drain.
+ */
+static bool isResizing(hashTable table) {
+    return (table->oldBuckets != NULL || table->oldOpen.control != NULL) ? true : false;
 }
 
 
-status displayHashElements(hashTable table) {
-    // Validate the hash table
-    if (!table) {
-        return failure; // Return failure if the table is NULL
-    }
+/*
+ * startResize:
+ * Allocates new storage of `newSize` buckets (or groups) and starts draining the current storage into it.
+ * Any resize still in progress is finished first. On allocation failure the table keeps its current storage.
+ */
+static status startResize(hashTable table, int newSize) {
+    migrateEntries(table, -1);
 
-    // Iterate through all buckets in the hash table
-    for (int i = 0; i < table->size; i++) {
-        // Display the elements in the linked list (bucket) at index i
-        displayList(table->buckets[i]);
+    if (table->backend == HASH_BACKEND_OPEN) {
+        OpenStore fresh;
+        if (createOpenStore(&fresh, (size_t)newSize) == failure) {
+            return failure;
+        }
+        table->oldOpen = table->open;
+        table->open = fresh;
+    } else {
+        uint64_t* freshOccupied;
+        KeyValuePair* fresh = createBuckets(newSize, &freshOccupied);
+        if (!fresh) {
+            return failure;
+        }
+        table->oldBuckets = table->buckets;
+        table->oldOccupied = table->occupied;
+        table->oldSize = table->size;
+        table->buckets = fresh;
+        table->occupied = freshOccupied;
+        table->size = newSize;
     }
 
-    return success; // Return success after displaying all elements
+    table->migrateIndex = 0;
+    return success;
 }
 
 
+/*
+ * currentSize / growthNeeded / shrinkAllowed:
+ * The number of buckets (or groups) entries are added to, and whether the load factor asks for more or fewer.
+ * Chained tables aim for at most one entry per bucket, open tables for at most 7/8 of their slots;
+ * both halve once they fall below a quarter of that.
+ */
+static int currentSize(hashTable table) {
+    return table->backend == HASH_BACKEND_OPEN ? (int)(table->open.groupMask + 1) : table->size;
+}
+
+static bool growthNeeded(hashTable table, int entries) {
+    long capacity = table->backend == HASH_BACKEND_OPEN
+                        ? (long)currentSize(table) * GROUP_WIDTH * MAX_LOAD_NUMERATOR / MAX_LOAD_DENOMINATOR
+                        : (long)currentSize(table);
+    return entries > capacity ? true : false;
+}
+
+static bool shrinkAllowed(hashTable table) {
+    long capacity = table->backend == HASH_BACKEND_OPEN
+                        ? (long)currentSize(table) * GROUP_WIDTH * MAX_LOAD_NUMERATOR / MAX_LOAD_DENOMINATOR
+                        : (long)currentSize(table);
+    return (currentSize(table) / 2 >= table->minimumSize && (long)table->count * 4 < capacity) ? true : false;
+}
+
+
+status reserveHashTable(hashTable table, int entries) {
+    // Validate the inputs; a frozen table holds exactly its entries and cannot take more
+    if (!table || entries < 0 || table->frozen) {
+        return failure;
+    }
+    if (!growthNeeded(table, entries)) {
+        migrateEntries(table, -1); // Already large enough; finish any resize so the bulk load runs at full speed
+        return success;
+    }
+
+    // Resize straight to the size that holds every entry, and move everything now rather than during the load
+    int newSize = table->backend == HASH_BACKEND_OPEN ? (int)groupsFor(entries) : entries;
+    if (startResize(table, newSize) == failure) {
+        return failure;
+    }
+    migrateEntries(table, -1);
+    return success;
+}
+
+
+
+status destroyHashTable(hashTable table) {
+    // Check if the hash table is NULL
+    if (table == NULL) {
+        return failure; // Return failure if the table is already NULL
+    }
+
+    destroyKeyFilter(table->filter);
+
+    if (table->frozen) {
+        // Every entry lives in the frozen store; the earlier storage was freed by freezeHashTable
+        destroyFrozenStore(table, table->frozen);
+        free(table);
+        return success;
+    }
+
+    if (table->backend == HASH_BACKEND_OPEN) {
+        // Free the key and value of every entry in both stores, then the table
+        destroyOpenStore(table, &table->open);
+        if (table->oldOpen.control != NULL) {
+            destroyOpenStore(table, &table->oldOpen);
+        }
+        free(table);
+        return success;
+    }
+
+    // Destroy every bucket with the pairs it holds, including the buckets not yet moved by a resize
+    for (int i = 0; i < table->size; i++) {
+        destroyBucket(table->buckets[i], &table->functions);
+    }
+    freeBuckets(table, table->buckets);
+    if (table->oldBuckets != NULL) {
+        for (int i = table->migrateIndex; i < table->oldSize; i++) {
+            destroyBucket(table->oldBuckets[i], &table->functions);
+        }
+        freeBuckets(table, table->oldBuckets);
+    }
+
+    // Free the memory allocated for the hash table structure itself
+    free(table);
+
+    // Set the table pointer to NULL to avoid dangling references
+    table = NULL;
+
+    return success; // Return success to indicate the table was successfully destroyed
+}
+
+
+static OpenSlot* currentOpenSlot(const HashTableIterator* iterator); // Defined with the iterator functions below
+
+/*
+ * rebuildFilter:
+ * Replaces the table's filter with one sized for twice the current entries and holding exactly their hashes,
+ * which drops the bits of removed keys. On allocation failure the old filter stays and failure is returned.
+ */
+static status rebuildFilter(hashTable table) {
+    int capacity = table->count * 2 > FILTER_MIN_CAPACITY ? table->count * 2 : FILTER_MIN_CAPACITY;
+    size_t blockCount = (size_t)capacity * FILTER_BITS_PER_ENTRY / (FILTER_BLOCK_WORDS * 64) + 1;
+    KeyFilter* filter = (KeyFilter*)malloc(sizeof(KeyFilter));
+    uint64_t* blocks = (uint64_t*)aligned_alloc(FILTER_BLOCK_WORDS * sizeof(uint64_t),
+                                                blockCount * FILTER_BLOCK_WORDS * sizeof(uint64_t));
+    if (!filter || !blocks) { // Check if memory allocation failed
+        free(filter);
+        free(blocks);
+        return failure;
+    }
+    memset(blocks, 0, blockCount * FILTER_BLOCK_WORDS * sizeof(uint64_t));
+    filter->blocks = blocks;
+    filter->blockCount = blockCount;
+    filter->capacity = capacity;
+    filter->stale = 0;
+
+    // Every entry keeps its mixed hash, so no key is hashed again
+    for (HashTableIterator it = hashTableBegin(table); hashTableIteratorValid(&it); hashTableIteratorNext(&it)) {
+        addToFilter(filter, table->backend == HASH_BACKEND_OPEN || table->frozen
+                                ? currentOpenSlot(&it)->hash
+                                : getKeyHash(it.entry));
+    }
+
+    destroyKeyFilter(table->filter);
+    table->filter = filter;
+    return success;
+}
+
+
+/*
+ * filterAfterInsert:
+ * Records a new entry in the filter, rebuilding the filter larger first once the table outgrew it
+ * (if that fails, the entry goes into the old filter, which only makes false positives more likely).
+ */
+static void filterAfterInsert(hashTable table, uint64_t hashValue) {
+    if (!table->filter) {
+        return;
+    }
+    if (table->count > table->filter->capacity && rebuildFilter(table) == success) {
+        return; // The rebuild already added every entry, this one included
+    }
+    addToFilter(table->filter, hashValue);
+}
+
+
+/*
+ * insertEntry:
+ * Adds a key (whose mixed hash is `hashValue`) and a value, held as keyMode and valueMode say,
+ * without looking for the key first. Returns the address of the stored value, or NULL on failure.
+ */
+static Element* insertEntry(hashTable table, Element key, Element value, uint64_t hashValue,
+                            HashOwnership keyMode, HashOwnership valueMode) {
+    // A frozen table refuses new entries (a taken key or value still belongs to the table, so it is freed)
+    if (table->frozen) {
+        if (keyMode == HASH_OWNERSHIP_TAKE) {
+            table->functions.free_key(key);
+        }
+        if (valueMode == HASH_OWNERSHIP_TAKE) {
+            table->functions.free_value(value);
+        }
+        return NULL;
+    }
+
+    // Grow once the new entry would push the load factor over its limit; if that fails the table just stays fuller
+    if (growthNeeded(table, table->count + 1)) {
+        if (isResizing(table)) {
+            migrateEntries(table, -1); // The storage being filled is full before the last resize finished
+        }
+        if (growthNeeded(table, table->count + 1)) {
+            // Open tables keep a power-of-two number of groups; chained tables keep an odd number of buckets
+            startResize(table, table->backend == HASH_BACKEND_OPEN ? currentSize(table) * 2
+                                                                   : currentSize(table) * 2 + 1);
+        }
+    }
+
+    /* Create copies of the key and value using the provided copy functions, unless the caller hands them over */
+    bool keyBorrowed = keyMode == HASH_OWNERSHIP_BORROW ? true : false;
+    FreeFunction freeKey = keyBorrowed ? keepElement : table->functions.free_key; // How this entry's key is released
+    Element keyCopy = keyMode == HASH_OWNERSHIP_COPY ? table->copy_key(key) : key; // Create a copy of the key
+    if (!keyCopy) { // Check if key copying failed
+        if (valueMode == HASH_OWNERSHIP_TAKE) {
+            table->functions.free_value(value); // The table owns a taken value even when the insert fails
+        }
+        return NULL; // Return NULL if unable to copy the key
+    }
+
+    Element valueCopy = valueMode == HASH_OWNERSHIP_COPY ? table->copy_value(value) : value; // Create a copy of the value
+    if (!valueCopy) { // Check if value copying failed
+        freeKey(keyCopy); // Free the key copy to prevent memory leaks
+        return NULL; // Return NULL if unable to copy the value
+    }
+
+    if (table->backend == HASH_BACKEND_OPEN) {
+        // An open store must keep a free slot; without room (growth failed) the entry cannot be added
+        if (growthNeeded(table, table->count + 1) &&
+            (size_t)table->count + 1 >= (table->open.groupMask + 1) * GROUP_WIDTH) {
+            freeKey(keyCopy);
+            table->functions.free_value(valueCopy);
+            return NULL;
+        }
+        size_t slot = placeInOpenStore(&table->open, hashValue, keyCopy, valueCopy, keyBorrowed);
+        table->count++;
+        filterAfterInsert(table, hashValue);
+        migrateEntries(table, MIGRATION_STEP); // Move a bounded part of a resize in progress (only into free slots)
+        return &table->open.slots[slot].value;
+    }
+
+    /* Create a KeyValuePair object to store the key and value */
+    KeyValuePair pair = createKeyValuePair(
+        keyCopy,
+        valueCopy,
+        keyBorrowed ? &table->borrowedKeyFunctions : &table->functions // Only used to free them if creation fails
+    );
+    if (!pair) { // Check if KeyValuePair creation failed
+        /* createKeyValuePair already freed the key and value copies */
+        return NULL; // Return NULL if unable to create the KeyValuePair
+    }
+    setKeyHash(pair, hashValue);
+    setKeyBorrowed(pair, keyBorrowed); // destroyKeyValuePair leaves a borrowed key to the caller
+
+    /* Calculate the hash index for the key */
+    int hash = reduceToRange(hashValue, table->size);
+    /* The hash index determines the bucket where the KeyValuePair will be stored */
+
+    /* Link the KeyValuePair at the end of the bucket's chain (the pair carries the link, so nothing else is allocated) */
+    appendToBucket(table->buckets, hash, pair);
+    setBit(table->occupied, (size_t)hash); // The bucket is not empty any more
+    table->count++;
+    filterAfterInsert(table, hashValue);
+    migrateEntries(table, MIGRATION_STEP); // Move a bounded part of a resize in progress (pairs keep their address)
+
+    return getValueSlot(pair); // Return where the value copy is stored
+}
+
+
+status addToHashTable(hashTable table, Element key, Element value) {
+    // Validate the inputs
+    if (!table || !key || !value) {
+        return failure; // Return failure if the table, key, or value is NULL
+    }
+
+    // Append the entry without checking for an existing one (findOrInsertInHashTable does check)
+    return insertEntry(table, key, value, mixedHash(table, key), HASH_OWNERSHIP_COPY, HASH_OWNERSHIP_COPY)
+               ? success : failure;
+}
+
+
+status addToHashTableWithOwnership(hashTable table, Element key, Element value,
+                                   HashOwnership keyMode, HashOwnership valueMode) {
+    // Validate the inputs; values are always released with free_value, so they cannot be borrowed
+    if (!table || !key || !value ||
+        (keyMode != HASH_OWNERSHIP_COPY && keyMode != HASH_OWNERSHIP_TAKE && keyMode != HASH_OWNERSHIP_BORROW) ||
+        (valueMode != HASH_OWNERSHIP_COPY && valueMode != HASH_OWNERSHIP_TAKE)) {
+        return failure; // Return failure if an argument is invalid
+    }
+
+    // Append the entry without checking for an existing one, holding the key and value as asked
+    return insertEntry(table, key, value, mixedHash(table, key), keyMode, valueMode) ? success : failure;
+}
+
+/*
+ * findPairInBucket:
+ * Returns the first pair of a bucket's chain whose key equals `key`, or NULL.
+ * Keys are only compared for pairs whose cached hash equals `hash`.
+ * previous (may be NULL) receives the pair before it in the chain, NULL if it is the first.
+ */
+static KeyValuePair findPairInBucket(hashTable table, KeyValuePair chain, Element key, uint64_t hash,
+                                     KeyValuePair* previous) {
+    // Start traversing the chain to find the key-value pair
+    KeyValuePair before = NULL;
+    for (KeyValuePair p = chain; p; before = p, p = getNextPair(p)) {
+        // Check if the key in the pair matches the lookup key, comparing the hashes first
+        if (getKeyHash(p) == hash && keysEqual(table, getKey(p), key)) {
+            if (previous) {
+                *previous = before;
+            }
+            return p;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * locateValueSlot:
+ * Returns the address of the value stored for a key (whose mixed hash is `hashValue`), or NULL if it is absent.
+ * Entries added before a resize in progress may still sit in the old storage, so both are searched.
+ */
+static Element* locateValueSlot(hashTable table, Element key, uint64_t hashValue) {
+    if (table->filter && !filterMayContain(table->filter, hashValue)) {
+        return NULL; // Certainly absent; the storage is not read at all
+    }
+
+    if (table->frozen) {
+        OpenSlot* slot = findFrozenSlot(table, key, hashValue);
+        return slot ? &slot->value : NULL;
+    }
+
+    if (table->backend == HASH_BACKEND_OPEN) {
+        // Look in the current store, then in the store still being drained
+        long slot = findOpenSlot(table, &table->open, key, hashValue);
+        if (slot >= 0) {
+            return &table->open.slots[slot].value;
+        }
+        if (table->oldOpen.control != NULL && (slot = findOpenSlot(table, &table->oldOpen, key, hashValue)) >= 0) {
+            return &table->oldOpen.slots[slot].value;
+        }
+        return NULL;
+    }
+
+    // Look in the old bucket while resizing, then in the current one
+    KeyValuePair p = NULL;
+    KeyValuePair oldBucket = findOldBucket(table, hashValue);
+    if (oldBucket) {
+        p = findPairInBucket(table, oldBucket, key, hashValue, NULL);
+    }
+    if (!p) {
+        p = findPairInBucket(table, table->buckets[reduceToRange(hashValue, table->size)], key, hashValue, NULL);
+    }
+    return p ? getValueSlot(p) : NULL;
+}
+
+
+/*
+ * findValueSlot:
+ * locateValueSlot for every lookup, recording the key compares of every samplePeriod-th one in the statistics.
+ */
+static Element* findValueSlot(hashTable table, Element key, uint64_t hashValue) {
+    if (table->samplePeriod == 0 || ++table->sampleTick < table->samplePeriod) {
+        return locateValueSlot(table, key, hashValue);
+    }
+
+    table->sampleTick = 0;
+    unsigned long comparesBefore = table->keyCompares;
+    Element* valueSlot = locateValueSlot(table, key, hashValue);
+    if (valueSlot) {
+        table->sampledHits++;
+        table->hitCompares += table->keyCompares - comparesBefore;
+    } else {
+        table->sampledMisses++;
+        table->missCompares += table->keyCompares - comparesBefore;
+    }
+    return valueSlot;
+}
+
+
+Element lookupInHashTable(hashTable table, Element key) {
+    // Validate the inputs
+    if (!table || !key) {
+        return NULL; // Return NULL if the hash table or key is invalid
+    }
+
+    // Hash the key once and return the value stored for it, or NULL if the key is not found
+    Element* valueSlot = findValueSlot(table, key, mixedHash(table, key));
+    return valueSlot ? *valueSlot : NULL;
+}
+
+
+/*
+ * prefetchEntry:
+ * Starts loading the memory a lookup of a key with this mixed hash will read first: the home group's control
+ * bytes and slots (open), the bucket's slot in the bucket array (chained) or the bucket seed (frozen; the slot
+ * depends on the seed). Nothing is read from the table's storage itself, so no call stalls on a miss.
+ * Only a hint; the old storage of a resize is not prefetched.
+ */
+static void prefetchEntry(hashTable table, uint64_t hashValue) {
+    if (table->filter) {
+        __builtin_prefetch(filterBlock(table->filter, hashValue));
+    }
+    if (table->frozen) {
+        __builtin_prefetch(&table->frozen->seeds[reduceToRange(hashValue, (int)table->frozen->bucketCount)]);
+    } else if (table->backend == HASH_BACKEND_OPEN) {
+        size_t group = homeGroup(&table->open, hashValue);
+        __builtin_prefetch(&table->open.control[group * GROUP_WIDTH]);
+        __builtin_prefetch(&table->open.slots[group * GROUP_WIDTH]);
+    } else {
+        __builtin_prefetch(&table->buckets[reduceToRange(hashValue, table->size)]);
+    }
+}
+
+
+/*
+ * prefetchChainHead:
+ * Second prefetch of a chained lookup: reads the bucket slot prefetchEntry asked for (in cache by now)
+ * and starts loading the bucket's first pair.
+ */
+static void prefetchChainHead(hashTable table, uint64_t hashValue) {
+    KeyValuePair head = table->buckets[reduceToRange(hashValue, table->size)];
+    if (head) {
+        __builtin_prefetch(head);
+    }
+}
+
+
+int lookupManyInHashTable(hashTable table, Element* keys, int count, Element* values) {
+    // Validate the inputs
+    if (!table || (count > 0 && (!keys || !values)) || count < 0) {
+        return -1; // Return -1 if an argument is invalid
+    }
+
+    int found = 0;
+    uint64_t hashes[LOOKUP_BATCH];
+    for (int first = 0; first < count; first += LOOKUP_BATCH) {
+        int batch = count - first < LOOKUP_BATCH ? count - first : LOOKUP_BATCH;
+
+        // First pass: hash the whole batch and prefetch where each key lives, so the cache misses overlap
+        for (int i = 0; i < batch; i++) {
+            if (keys[first + i]) {
+                hashes[i] = mixedHash(table, keys[first + i]);
+                prefetchEntry(table, hashes[i]);
+            }
+        }
+
+        // Chained buckets are reached through the bucket array, so their first pairs are prefetched in a pass
+        // of their own once the array slots have arrived
+        if (table->backend == HASH_BACKEND_CHAINED && !table->frozen) {
+            for (int i = 0; i < batch; i++) {
+                if (keys[first + i]) {
+                    prefetchChainHead(table, hashes[i]);
+                }
+            }
+        }
+
+        // Last pass: resolve the keys, whose memory is (mostly) in cache by now
+        for (int i = 0; i < batch; i++) {
+            Element* valueSlot = keys[first + i] ? findValueSlot(table, keys[first + i], hashes[i]) : NULL;
+            values[first + i] = valueSlot ? *valueSlot : NULL;
+            if (valueSlot) {
+                found++;
+            }
+        }
+    }
+    return found;
+}
+
+
+Element* findOrInsertInHashTable(hashTable table, Element key, Element value, bool* existed) {
+    // Validate the inputs
+    if (!table || !key || !value || !existed) {
+        return NULL; // Return NULL if any argument is missing
+    }
+
+    // One hash for the search and, if the key is absent, for the insertion
+    uint64_t hashValue = mixedHash(table, key);
+    Element* valueSlot = findValueSlot(table, key, hashValue);
+    if (valueSlot) {
+        *existed = true; // Leave the stored value as it is
+        return valueSlot;
+    }
+
+    *existed = false;
+    return insertEntry(table, key, value, hashValue, HASH_OWNERSHIP_COPY, HASH_OWNERSHIP_COPY);
+}
+
+
+status upsertHashTable(hashTable table, Element key, Element value, bool* existed) {
+    // Validate the inputs
+    if (!table || !key || !value) {
+        return failure; // Return failure if the table, key, or value is NULL
+    }
+
+    bool found;
+    Element* valueSlot = findOrInsertInHashTable(table, key, value, &found);
+    if (!valueSlot) {
+        return failure; // Return failure if the entry could not be added
+    }
+    if (found) {
+        // Replace the stored value with a copy of the new one
+        Element valueCopy = table->copy_value(value);
+        if (!valueCopy) {
+            return failure; // The old value stays in place
+        }
+        table->functions.free_value(*valueSlot);
+        *valueSlot = valueCopy;
+    }
+    if (existed) {
+        *existed = found; // Tell the caller whether an older value was replaced
+    }
+    return success;
+}
+
+
+/*
+ * afterRemoval:
+ * Counts a removed entry, rebuilds the filter once it holds too many removed keys, shrinks the table if it became
+ * sparse, and moves a bounded part of a resize in progress.
+ */
+static void afterRemoval(hashTable table) {
+    table->count--;
+    if (table->filter && ++table->filter->stale > table->count / 2 + FILTER_MIN_CAPACITY) {
+        rebuildFilter(table); // Too many bits of removed keys; if that fails the old filter is still correct
+    }
+    if (!isResizing(table) && shrinkAllowed(table)) {
+        startResize(table, currentSize(table) / 2); // If that fails the table simply stays larger
+    }
+    migrateEntries(table, MIGRATION_STEP);
+}
+
+
+status removeFromHashTable(hashTable table, Element key) {
+    // Validate the inputs; the keys of a frozen table never change
+    if (!table || !key || table->frozen) {
+        return failure; // Return failure if the hash table or key is invalid
+    }
+
+    // Hash the key once; the same hash checks the filter, finds the bucket (or group) and filters the entries
+    uint64_t hashValue = mixedHash(table, key);
+    if (table->filter && !filterMayContain(table->filter, hashValue)) {
+        return failure; // The key is certainly absent
+    }
+
+    if (table->backend == HASH_BACKEND_OPEN) {
+        long slot = findOpenSlot(table, &table->open, key, hashValue);
+        if (slot >= 0) {
+            removeOpenSlot(table, (size_t)slot);
+        } else if (table->oldOpen.control != NULL &&
+                   (slot = findOpenSlot(table, &table->oldOpen, key, hashValue)) >= 0) {
+            // The old store is only drained, never probed for free slots, so a marker is enough there
+            releaseOpenSlot(table, &table->oldOpen.slots[slot]);
+            table->oldOpen.control[slot] = CONTROL_MOVED;
+            updateGroupOccupancy(&table->oldOpen, (size_t)slot / GROUP_WIDTH);
+        } else {
+            return failure; // Return failure if the key was not found
+        }
+        afterRemoval(table);
+        return success;
+    }
+
+    // The search remembers the pair before the match, so unlinking it compares no key again
+    int hash = reduceToRange(hashValue, table->size);
+
+    // Look in the old bucket first while resizing, then in the current one
+    KeyValuePair previous = NULL;
+    KeyValuePair bucket = findOldBucket(table, hashValue);
+    KeyValuePair p = bucket ? findPairInBucket(table, bucket, key, hashValue, &previous) : NULL;
+    KeyValuePair* buckets = table->oldBuckets;
+    uint64_t* occupied = table->oldOccupied;
+    if (p) {
+        hash = reduceToRange(hashValue, table->oldSize);
+    } else {
+        // Search the chain of the bucket at the computed hash index
+        buckets = table->buckets;
+        occupied = table->occupied;
+        p = findPairInBucket(table, table->buckets[hash], key, hashValue, &previous);
+    }
+    if (!p) {
+        // Return failure if the key was not found in the bucket
+        return failure;
+    }
+
+    // Unlink the pair from its chain, then destroy it
+    if (previous) {
+        setNextPair(previous, getNextPair(p));
+    } else {
+        buckets[hash] = getNextPair(p);
+    }
+    destroyKeyValuePair(p, &table->functions);
+    if (!buckets[hash]) {
+        clearBit(occupied, (size_t)hash); // Full scans skip the empty bucket from now on
+    }
+    afterRemoval(table);
+    return success; // Return success after removing the key-value pair
+}
+
+
+/*
+ * seekEntry:
+ * Moves an iterator forward to the first entry at or after its current position: slot `position` of an open store,
+ * or bucket `position` of the chained buckets. The old storage (its part not moved yet) comes before the current one.
+ * Empty regions are skipped through the occupancy bitmaps.
+ */
+static void seekEntry(HashTableIterator* iterator) {
+    hashTable table = iterator->table;
+    if (table->frozen) {
+        // Every slot of a frozen table is full: position runs over the slots, then over the twins
+        iterator->storage = iterator->position < table->frozen->slotCount + table->frozen->twinCount ? 1 : 2;
+        return;
+    }
+    while (iterator->storage < 2) {
+        bool old = iterator->storage == 0 ? true : false;
+
+        if (table->backend == HASH_BACKEND_OPEN) {
+            OpenStore* store = old ? &table->oldOpen : &table->open;
+            if (store->control != NULL) {
+                size_t groups = store->groupMask + 1;
+                size_t group = iterator->position / GROUP_WIDTH;
+                // Entries of the current group at or after the position, then the next occupied groups
+                uint64_t match = group < groups ? matchFull(loadGroup(store, group))
+                                                  & (~0ULL << (8 * (iterator->position % GROUP_WIDTH))) : 0;
+                while (match == 0 && (group = nextSetBit(store->occupied, groups, group + 1)) < groups) {
+                    match = matchFull(loadGroup(store, group));
+                }
+                if (match != 0) {
+                    iterator->position = slotInGroup(group, match);
+                    return;
+                }
+            }
+        } else {
+            KeyValuePair* buckets = old ? table->oldBuckets : table->buckets;
+            if (buckets != NULL) {
+                uint64_t* occupied = old ? table->oldOccupied : table->occupied;
+                size_t size = (size_t)(old ? table->oldSize : table->size);
+                for (size_t bucket = nextSetBit(occupied, size, iterator->position); bucket < size;
+                     bucket = nextSetBit(occupied, size, bucket + 1)) {
+                    iterator->position = bucket;
+                    iterator->entry = buckets[bucket];
+                    if (iterator->entry) {
+                        return;
+                    }
+                }
+            }
+        }
+
+        // Nothing left in this storage; continue with the current one
+        iterator->storage++;
+        iterator->position = 0;
+    }
+}
+
+
+HashTableIterator hashTableBegin(hashTable table) {
+    HashTableIterator iterator;
+    memset(&iterator, 0, sizeof(iterator));
+    iterator.table = table;
+    iterator.storage = table ? 0 : 2; // A NULL table has no entries
+    if (table) {
+        seekEntry(&iterator);
+    }
+    return iterator;
+}
+
+
+bool hashTableIteratorValid(const HashTableIterator* iterator) {
+    return (iterator && iterator->storage < 2) ? true : false;
+}
+
+
+void hashTableIteratorNext(HashTableIterator* iterator) {
+    if (!hashTableIteratorValid(iterator)) {
+        return;
+    }
+    if (iterator->table->backend == HASH_BACKEND_CHAINED && !iterator->table->frozen) {
+        // Continue along the same bucket's chain before looking for the next bucket
+        iterator->entry = getNextPair(iterator->entry);
+        if (iterator->entry) {
+            return;
+        }
+    }
+    iterator->position++;
+    seekEntry(iterator);
+}
+
+
+/*
+ * currentOpenSlot:
+ * The slot an iterator over an open (or frozen) table stands on.
+ */
+static OpenSlot* currentOpenSlot(const HashTableIterator* iterator) {
+    const FrozenStore* frozen = iterator->table->frozen;
+    if (frozen) {
+        return iterator->position < frozen->slotCount ? &frozen->slots[iterator->position]
+                                                      : &frozen->twins[iterator->position - frozen->slotCount];
+    }
+    OpenStore* store = iterator->storage == 0 ? &iterator->table->oldOpen : &iterator->table->open;
+    return &store->slots[iterator->position];
+}
+
+
+Element hashTableIteratorKey(const HashTableIterator* iterator) {
+    if (!hashTableIteratorValid(iterator)) {
+        return NULL;
+    }
+    if (iterator->table->backend == HASH_BACKEND_OPEN || iterator->table->frozen) {
+        return currentOpenSlot(iterator)->key;
+    }
+    return getKey(iterator->entry);
+}
+
+
+Element hashTableIteratorValue(const HashTableIterator* iterator) {
+    if (!hashTableIteratorValid(iterator)) {
+        return NULL;
+    }
+    if (iterator->table->backend == HASH_BACKEND_OPEN || iterator->table->frozen) {
+        return currentOpenSlot(iterator)->value;
+    }
+    return getValue(iterator->entry);
+}
+
+
+/*
+ * compareSlotHashes:
+ * qsort comparison of slots by mixed hash, which brings the entries sharing a hash together.
+ */
+static int compareSlotHashes(const void* a, const void* b) {
+    uint64_t first = ((const OpenSlot*)a)->hash, second = ((const OpenSlot*)b)->hash;
+    return (first > second) - (first < second);
+}
+
+
+/*
+ * seedFrozenBucket:
+ * Searches a seed that sends the `size` entries of one bucket to slots that neither another bucket nor
+ * the bucket itself took yet, claims those slots in `taken` and fills them.
+ * Returns false if no seed up to FROZEN_MAX_SEED works.
+ */
+static bool seedFrozenBucket(FrozenStore* frozen, const OpenSlot* entries, const size_t* members, size_t size,
+                             uint64_t* taken, size_t* positions, uint32_t* seed) {
+    for (uint32_t candidate = 1; candidate <= FROZEN_MAX_SEED; candidate++) {
+        size_t placed = 0;
+        while (placed < size) {
+            size_t position = frozenPosition(entries[members[placed]].hash, candidate, frozen->slotCount);
+            if (testBit(taken, position)) {
+                break;
+            }
+            setBit(taken, position);
+            positions[placed++] = position;
+        }
+        if (placed == size) {
+            for (size_t i = 0; i < size; i++) {
+                frozen->slots[positions[i]] = entries[members[i]];
+            }
+            *seed = candidate;
+            return true;
+        }
+        while (placed > 0) {
+            clearBit(taken, positions[--placed]); // Give back the slots of a seed that did not fit
+        }
+    }
+    return false;
+}
+
+
+status freezeHashTable(hashTable table) {
+    // Validate the input; freezing twice changes nothing
+    if (!table) {
+        return failure;
+    }
+    if (table->frozen) {
+        return success;
+    }
+
+    // Gather the entries from a single storage
+    migrateEntries(table, -1);
+    if (isResizing(table)) {
+        return failure; // A chained resize could not finish for lack of memory
+    }
+    size_t count = (size_t)table->count;
+    FrozenStore* frozen = (FrozenStore*)calloc(1, sizeof(FrozenStore));
+    OpenSlot* entries = (OpenSlot*)malloc((count + 1) * sizeof(OpenSlot));
+    if (!frozen || !entries) { // Check if memory allocation failed
+        free(frozen);
+        free(entries);
+        return failure;
+    }
+
+    // Only the pointers are copied; the keys and values change hands once the freeze has succeeded
+    size_t gathered = 0;
+    for (HashTableIterator it = hashTableBegin(table); hashTableIteratorValid(&it); hashTableIteratorNext(&it)) {
+        OpenSlot* entry = &entries[gathered++];
+        if (table->backend == HASH_BACKEND_OPEN) {
+            *entry = *currentOpenSlot(&it);
+        } else {
+            KeyValuePair pair = it.entry;
+            entry->key = getKey(pair);
+            entry->value = getValue(pair);
+            entry->hash = getKeyHash(pair);
+            entry->keyBorrowed = isKeyBorrowed(pair);
+        }
+    }
+
+    // Sort by hash: the first entry of each hash goes into the perfect hash, the others (twins) beside it,
+    // since no seed can tell apart two keys that hash the same
+    qsort(entries, count, sizeof(OpenSlot), compareSlotHashes);
+    size_t twinCount = 0;
+    for (size_t i = 1; i < count; i++) {
+        if (entries[i].hash == entries[i - 1].hash) {
+            twinCount++;
+        }
+    }
+    frozen->twins = (OpenSlot*)malloc((twinCount + 1) * sizeof(OpenSlot));
+    size_t unique = 0;
+    for (size_t i = 0; i < count && frozen->twins; i++) {
+        if (unique > 0 && entries[i].hash == entries[unique - 1].hash) {
+            frozen->twins[frozen->twinCount++] = entries[i];
+        } else {
+            entries[unique++] = entries[i];
+        }
+    }
+
+    // About FROZEN_BUCKET_LOAD keys share each bucket, and exactly one slot per distinct hash
+    frozen->slotCount = unique;
+    frozen->bucketCount = unique / FROZEN_BUCKET_LOAD + 1;
+    frozen->seeds = (uint32_t*)calloc(frozen->bucketCount, sizeof(uint32_t));
+    frozen->slots = (OpenSlot*)malloc((unique + 1) * sizeof(OpenSlot));
+    size_t* bucketStart = (size_t*)calloc(frozen->bucketCount + 1, sizeof(size_t));
+    size_t* members = (size_t*)malloc((unique + 1) * sizeof(size_t));
+    uint64_t* taken = createBitmap(unique + 1);
+    size_t* positions = NULL;
+    status result = (frozen->twins && frozen->seeds && frozen->slots && bucketStart && members && taken)
+                        ? success : failure;
+
+    if (result == success) {
+        // Group the entries by bucket (a counting sort); bucket b holds members[bucketStart[b] .. bucketStart[b + 1] - 1]
+        for (size_t i = 0; i < unique; i++) {
+            bucketStart[reduceToRange(entries[i].hash, (int)frozen->bucketCount) + 1]++;
+        }
+        size_t largest = 0;
+        for (size_t b = 0; b < frozen->bucketCount; b++) {
+            largest = bucketStart[b + 1] > largest ? bucketStart[b + 1] : largest;
+            bucketStart[b + 1] += bucketStart[b];
+        }
+        for (size_t i = 0; i < unique; i++) {
+            members[bucketStart[reduceToRange(entries[i].hash, (int)frozen->bucketCount)]++] = i;
+        }
+        for (size_t b = frozen->bucketCount; b > 0; b--) {
+            bucketStart[b] = bucketStart[b - 1]; // The fill moved every start to the next bucket's start
+        }
+        bucketStart[0] = 0;
+
+        // Seed the largest buckets first, while most slots are free; lone keys then take the slots left over
+        positions = (size_t*)malloc((largest + 1) * sizeof(size_t));
+        result = positions ? success : failure;
+        for (size_t size = largest; size >= 2 && result == success; size--) {
+            for (size_t b = 0; b < frozen->bucketCount && result == success; b++) {
+                if (bucketStart[b + 1] - bucketStart[b] == size &&
+                    !seedFrozenBucket(frozen, entries, &members[bucketStart[b]], size, taken, positions,
+                                      &frozen->seeds[b])) {
+                    result = failure;
+                }
+            }
+        }
+        size_t freeSlot = 0;
+        for (size_t b = 0; b < frozen->bucketCount && result == success; b++) {
+            if (bucketStart[b + 1] - bucketStart[b] == 1) {
+                while (testBit(taken, freeSlot)) {
+                    freeSlot++;
+                }
+                setBit(taken, freeSlot);
+                frozen->slots[freeSlot] = entries[members[bucketStart[b]]];
+                frozen->seeds[b] = FROZEN_DIRECT | (uint32_t)freeSlot;
+            }
+        }
+    }
+    free(positions);
+    free(taken);
+    free(members);
+    free(bucketStart);
+    free(entries);
+    if (result == failure) {
+        // The table keeps its entries in the storage they are in
+        free(frozen->seeds);
+        free(frozen->slots);
+        free(frozen->twins);
+        free(frozen);
+        return failure;
+    }
+
+    // The frozen store holds the keys and values now, so the earlier storage goes without them
+    if (table->backend == HASH_BACKEND_OPEN) {
+        free(table->open.control);
+        free(table->open.slots);
+        free(table->open.occupied);
+        table->open.control = NULL;
+        table->open.slots = NULL;
+        table->open.occupied = NULL;
+    } else {
+        // The pairs go with functions that keep every key and value
+        KeyValueFunctions keepEverything = table->functions;
+        keepEverything.free_key = keepElement;
+        keepEverything.free_value = keepElement;
+        for (int i = 0; i < table->size; i++) {
+            destroyBucket(table->buckets[i], &keepEverything);
+        }
+        freeBuckets(table, table->buckets);
+        table->buckets = NULL;
+        table->occupied = NULL;
+    }
+    table->frozen = frozen;
+    return success;
+}
+
+
+status enableHashTableFilter(hashTable table) {
+    // Validate the input; enabling twice keeps the filter there is
+    if (!table) {
+        return failure;
+    }
+    return table->filter ? success : rebuildFilter(table);
+}
+
+
+status sampleHashTableLookups(hashTable table, int period) {
+    // Validate the inputs
+    if (!table || period < 0) {
+        return failure;
+    }
+
+    // Start over, so the averages describe the traffic from now on
+    table->samplePeriod = period;
+    table->sampleTick = 0;
+    table->sampledHits = 0;
+    table->sampledMisses = 0;
+    table->hitCompares = 0;
+    table->missCompares = 0;
+    return success;
+}
+
+
+/*
+ * addLength:
+ * Counts one chain (or probe) of the given length in the statistics' histogram and longest length.
+ */
+static void addLength(HashTableStats* stats, int length) {
+    stats->lengths[length < HASH_STATS_LENGTHS ? length : HASH_STATS_LENGTHS - 1]++;
+    if (length > stats->longest) {
+        stats->longest = length;
+    }
+}
+
+
+/*
+ * chainLength:
+ * The number of pairs in a bucket's chain.
+ */
+static int chainLength(KeyValuePair chain) {
+    int length = 0;
+    for (; chain; chain = getNextPair(chain)) {
+        length++;
+    }
+    return length;
+}
+
+
+/*
+ * addOpenStoreLengths:
+ * Counts the probe length of every entry of an open store: the number of groups a lookup of its key reads.
+ */
+static void addOpenStoreLengths(const OpenStore* store, HashTableStats* stats) {
+    size_t slotCount = (store->groupMask + 1) * GROUP_WIDTH;
+    for (size_t i = 0; i < slotCount; i++) {
+        if (store->control[i] < CONTROL_EMPTY) { // Full slots hold a 7-bit tag
+            size_t distance = (i / GROUP_WIDTH - homeGroup(store, store->slots[i].hash)) & store->groupMask;
+            addLength(stats, (int)distance + 1);
+        }
+    }
+}
+
+
+status getHashTableStats(hashTable table, HashTableStats* stats) {
+    // Validate the inputs
+    if (!table || !stats) {
+        return failure;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->entries = table->count;
+
+    // The shape of the storage; the part of a resize not moved yet is counted too, without moving it
+    if (table->frozen) {
+        stats->buckets = (int)table->frozen->slotCount;
+        stats->lengths[1] = (int)table->frozen->slotCount;         // One slot read
+        stats->lengths[2] = (int)table->frozen->twinCount;         // The slot, then the twins
+        stats->longest = table->frozen->twinCount > 0 ? 2 : (table->frozen->slotCount > 0 ? 1 : 0);
+    } else if (table->backend == HASH_BACKEND_OPEN) {
+        stats->buckets = (int)((table->open.groupMask + 1) * GROUP_WIDTH);
+        addOpenStoreLengths(&table->open, stats);
+        if (table->oldOpen.control != NULL) {
+            addOpenStoreLengths(&table->oldOpen, stats);
+        }
+    } else {
+        stats->buckets = table->size;
+        for (int i = 0; i < table->size; i++) {
+            addLength(stats, chainLength(table->buckets[i]));
+        }
+        for (int i = table->migrateIndex; table->oldBuckets != NULL && i < table->oldSize; i++) {
+            addLength(stats, chainLength(table->oldBuckets[i]));
+        }
+    }
+    stats->loadFactor = stats->buckets > 0 ? (double)stats->entries / stats->buckets : 0.0;
+
+    // The cost of the sampled lookups
+    stats->sampledHits = table->sampledHits;
+    stats->sampledMisses = table->sampledMisses;
+    stats->comparesPerHit = table->sampledHits ? (double)table->hitCompares / (double)table->sampledHits : 0.0;
+    stats->comparesPerMiss = table->sampledMisses ? (double)table->missCompares / (double)table->sampledMisses : 0.0;
+    return success;
+}
+
+
+status displayHashTableStats(hashTable table) {
+    HashTableStats stats;
+    if (getHashTableStats(table, &stats) == failure) {
+        return failure;
+    }
+
+    const char* unit = (table->backend == HASH_BACKEND_OPEN || table->frozen) ? "slots" : "buckets";
+    printf("Entries : %d, %s : %d, load factor : %.2f\n", stats.entries, unit, stats.buckets, stats.loadFactor);
+    printf("Longest %s : %d\n", table->backend == HASH_BACKEND_OPEN || table->frozen ? "probe" : "chain",
+           stats.longest);
+    printf("Lengths :");
+    for (int i = 0; i < HASH_STATS_LENGTHS; i++) {
+        if (stats.lengths[i] > 0) {
+            printf(" %d%s:%d", i, i == HASH_STATS_LENGTHS - 1 ? "+" : "", stats.lengths[i]);
+        }
+    }
+    printf("\n");
+    printf("Key compares per hit : %.2f (%lu sampled), per miss : %.2f (%lu sampled)\n",
+           stats.comparesPerHit, stats.sampledHits, stats.comparesPerMiss, stats.sampledMisses);
+    return success;
+}
+
+
+int hashTableCount(hashTable table) {
+    // The number of entries is kept up to date by every add and remove
+    return table ? table->count : -1;
+}
+
+
+status displayHashElements(hashTable table) {
+    // Validate the hash table
+    if (!table) {
+        return failure; // Return failure if the table is NULL
+    }
+
+    // Display the key and value of every entry; empty buckets and groups are skipped
+    for (HashTableIterator it = hashTableBegin(table); hashTableIteratorValid(&it); hashTableIteratorNext(&it)) {
+        table->functions.print_key(hashTableIteratorKey(&it));
+        table->functions.print_value(hashTableIteratorValue(&it));
+    }
+
+    return success; // Return success after displaying all elements
+}
+
+
+#define STRING_HASH_P0 0xa0761d6478bd642fULL // Odd 64-bit constants of the string hash's mixing rounds
+#define STRING_HASH_P1 0xe7037ed1a0b428dbULL
+#define STRING_HASH_P2 0x8ebc6af09c88c6e3ULL
+
+static uint64_t stringHashSeed = 0x9e3779b97f4a7c15ULL; // Seed of hashString, set with setStringHashSeed
+
+/*
+ * multiplyFold:
+ * Multiplies two 64-bit words into 128 bits and folds the halves together with xor,
+ * so every input bit affects every output bit.
+ */
+static uint64_t multiplyFold(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 product = (unsigned __int128)a * b;
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+#else
+    // Schoolbook 64x64 -> 128 multiplication from 32-bit halves
+    uint64_t aLow = (uint32_t)a, aHigh = a >> 32, bLow = (uint32_t)b, bHigh = b >> 32;
+    uint64_t lowLow = aLow * bLow, lowHigh = aLow * bHigh, highLow = aHigh * bLow, highHigh = aHigh * bHigh;
+    uint64_t middle = (lowLow >> 32) + (uint32_t)lowHigh + (uint32_t)highLow;
+    uint64_t low = (middle << 32) | (uint32_t)lowLow;
+    uint64_t high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+    return low ^ high;
+#endif
+}
+
+/*
+ * readWord:
+ * Reads up to 8 bytes of a string as a little-endian word (missing bytes are zero).
+ */
+static uint64_t readWord(const unsigned char* bytes, size_t length) {
+    uint64_t word = 0;
+    memcpy(&word, bytes, length < sizeof(word) ? length : sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+
+void setStringHashSeed(unsigned long long seed) {
+    stringHashSeed = (uint64_t)seed;
+}
+
+
+/*
+ * hashStringFully:
+ * The 64-bit seeded hash of a NUL-terminated string (NULL hashes to 0). Tables keyed with hashString use all of
+ * it (mixedHash); hashString itself returns only the part an int can hold.
+ */
+static uint64_t hashStringFully(Element key) {
+    if (!key) return 0;
+    const unsigned char* bytes = (const unsigned char*)key;
+    size_t length = strlen((const char*)key);
+    uint64_t state = stringHashSeed ^ multiplyFold(stringHashSeed ^ STRING_HASH_P0, STRING_HASH_P1);
+
+    // Consume the string 16 bytes (two words) per round
+    size_t remaining = length;
+    while (remaining > 16) {
+        state = multiplyFold(readWord(bytes, 8) ^ STRING_HASH_P1, readWord(bytes + 8, 8) ^ state);
+        bytes += 16;
+        remaining -= 16;
+    }
+
+    // Mix the last 0..16 bytes with the length
+    uint64_t first = readWord(bytes, remaining);
+    uint64_t second = remaining > 8 ? readWord(bytes + 8, remaining - 8) : 0;
+    uint64_t hash = multiplyFold(STRING_HASH_P1 ^ (uint64_t)length,
+                                 multiplyFold(first ^ STRING_HASH_P1, second ^ state) ^ STRING_HASH_P2);
+    return hash;
+}
+
+
+int hashString(Element key) {
+    // TransformIntoNumberFunction results are ints; keep 31 well-mixed bits so the result is never negative
+    return (int)(hashStringFully(key) >> 33);
+}
@@ -2,14 +2,114 @@
 #ifndef HASH_TABLE_H
 #define HASH_TABLE_H
 #include "Defs.h"
+#include "KeyValuePair.h"
 
 typedef struct hashTable_s *hashTable;
 
+// Ways a hash table can store its entries
+typedef enum e_hashBackend {
+    HASH_BACKEND_CHAINED, // Buckets of chained key-value pairs (the backend createHashTable uses)
+    HASH_BACKEND_OPEN     // Open addressing: one flat slot array probed 8 control bytes at a time, grown as needed
+} HashBackend;
+
+// How an insert hands a key or value over to the table
+typedef enum e_hashOwnership {
+    HASH_OWNERSHIP_COPY,  // The table stores a copy made with the copy function and frees it (what addToHashTable does)
+    HASH_OWNERSHIP_TAKE,  // The table stores the caller's pointer as is and frees it with the free function
+    HASH_OWNERSHIP_BORROW // Keys only: the table stores the caller's pointer and never frees it;
+                          // the key must stay unchanged until the entry is removed or the table destroyed
+} HashOwnership;
+
+// Lengths the statistics' histogram tells apart; its last entry also counts everything longer
+#define HASH_STATS_LENGTHS 16
+
+// Shape and lookup cost of a hash table, filled in by getHashTableStats
+typedef struct Hash_Table_Stats {
+    int entries;                      // Entries stored
+    int buckets;                      // Buckets (chained) or slots (open, frozen) of the storage
+    double loadFactor;                // Entries per bucket or slot
+    int lengths[HASH_STATS_LENGTHS];  // Chained: buckets holding i entries; open: entries found after reading i groups;
+                                      // frozen: entries found after reading i slots
+    int longest;                      // The longest chain (chained) or probe (open, frozen)
+    unsigned long sampledHits;        // Sampled lookups that found their key (see sampleHashTableLookups)
+    unsigned long sampledMisses;      // Sampled lookups that did not
+    double comparesPerHit;            // Average key compares of a sampled hit
+    double comparesPerMiss;           // Average key compares of a sampled miss
+} HashTableStats;
+
+// Cursor over the entries of a hash table (in no particular order).
+// Adding or removing entries invalidates it; values may be replaced through findOrInsertInHashTable meanwhile.
+typedef struct Hash_Table_Iterator {
+    hashTable table;     // The table being traversed
+    int storage;         // 0 while in storage a resize is still draining, 1 in the current storage, 2 past the end
+    size_t position;     // The slot (open backend) or bucket (chained backend) the iterator stands on
+    KeyValuePair entry;  // The entry within the bucket's chain (chained backend only)
+} HashTableIterator;
+
 hashTable createHashTable(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey, CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue, EqualFunction equalKey, TransformIntoNumberFunction transformIntoNumber, int hashNumber);
+// Same as createHashTable with a chosen backend; every other function works the same for both backends.
+// For HASH_BACKEND_OPEN, hashNumber is the number of entries expected rather than a bucket count.
+hashTable createHashTableWithBackend(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey, CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue, EqualFunction equalKey, TransformIntoNumberFunction transformIntoNumber, int hashNumber, HashBackend backend);
 status destroyHashTable(hashTable);
+// Adds the entry without checking whether the key is already present.
 status addToHashTable(hashTable, Element key,Element value);
+// Same as addToHashTable, without copying the key or value where keyMode or valueMode say so.
+// Once the arguments are accepted, a taken key or value belongs to the table, which frees it if the insert fails.
+status addToHashTableWithOwnership(hashTable, Element key, Element value, HashOwnership keyMode, HashOwnership valueMode);
 Element lookupInHashTable(hashTable, Element key);
+// Looks up count keys at once, storing each value (or NULL if the key is absent or NULL) in values[i].
+// Keys are hashed and their buckets prefetched a batch at a time before being resolved, so the cache misses of
+// a batch overlap instead of stalling one lookup after another. Returns the number of keys found, or -1.
+int lookupManyInHashTable(hashTable, Element* keys, int count, Element* values);
+// Finds the key or, if it is absent, adds copies of key and value, hashing and probing the table once.
+// *existed tells which happened. Returns the address of the stored value (to read or replace in place;
+// a replaced value must be one the table can free), valid until the table is next changed, or NULL on failure.
+Element* findOrInsertInHashTable(hashTable, Element key, Element value, bool* existed);
+// Adds the entry, or replaces the stored value of an existing key with a copy of value (freeing the old one).
+// existed may be NULL; otherwise it tells whether the key was already present.
+status upsertHashTable(hashTable, Element key, Element value, bool* existed);
 status removeFromHashTable(hashTable, Element key);
 status displayHashElements(hashTable);
+// Number of entries in the table, or -1 for a NULL table.
+int hashTableCount(hashTable);
+// Iteration over all entries. Occupancy bitmaps let it skip 64 empty buckets (or groups) per step,
+// so a full scan costs time proportional to the number of entries rather than the capacity:
+//     for (HashTableIterator it = hashTableBegin(t); hashTableIteratorValid(&it); hashTableIteratorNext(&it))
+HashTableIterator hashTableBegin(hashTable);
+bool hashTableIteratorValid(const HashTableIterator* iterator);
+void hashTableIteratorNext(HashTableIterator* iterator);
+Element hashTableIteratorKey(const HashTableIterator* iterator);
+Element hashTableIteratorValue(const HashTableIterator* iterator);
+// Tables grow once they pass their load factor and shrink (never below their initial size) once they are sparse;
+// the entries move to the new storage a few buckets per add or remove, so no single call pays for the whole rehash.
+// Grows the table at once to hold `entries` entries without any further resize, e.g. before a bulk load.
+status reserveHashTable(hashTable, int entries);
+// Turns the table, once its keys will not change any more (e.g. a reference table after loading), into a minimal
+// perfect hash: each bucket of about four keys keeps a seed that sends every one of its keys to a slot of its own
+// in one compact array, so a lookup reads one seed and one slot and compares one key, with no chains or probing.
+// From then on adds, removes and reserveHashTable fail; values may still be replaced (upsertHashTable,
+// findOrInsertInHashTable). On failure (out of memory) the table stays as it was. Freezing twice does nothing.
+status freezeHashTable(hashTable);
+// Puts a blocked Bloom filter (about 2-4 bytes per entry) in front of the table: most lookups and removes of absent
+// keys are then answered from one cache line of the filter, without reading the buckets or comparing any key.
+// The filter grows with the table and is rebuilt once removed keys left too many stale bits; it never turns away
+// a key that is present. Returns failure (the table works as before) if memory runs out.
+status enableHashTableFilter(hashTable);
+// Diagnostics. The histogram shows how evenly the keys spread; a degenerate TransformIntoNumberFunction shows up as
+// long chains (or probes) and as more than one key compare per lookup, since entries are only compared on equal hashes.
+// getHashTableStats walks the whole table; it counts the part of a resize not moved yet without moving it.
+status getHashTableStats(hashTable, HashTableStats* stats);
+// Prints the statistics: sizes, load factor, longest chain, histogram and sampled compares.
+status displayHashTableStats(hashTable);
+// Records the key compares of every period-th lookup from now on (0 stops), restarting the sampled averages.
+// While sampling, lookups update the table's counters; otherwise they only read it, so several threads may look up
+// (but not change) a table at once.
+status sampleHashTableLookups(hashTable, int period);
+// Ready-made TransformIntoNumberFunction for NUL-terminated string keys: a seeded hash that reads 8 bytes at a time,
+// so anagrams and same-length strings (which a sum of characters maps together) land in different buckets.
+// It returns the top 31 bits of a 64-bit hash (0 to INT_MAX); tables created with it hash keys with all 64 bits.
+int hashString(Element key);
+// Changes the seed of hashString. Tables already holding string keys must not be used with it afterwards.
+void setStringHashSeed(unsigned long long seed);
 
 #endif /* HASH_TABLE_H */
@@ -48,6 +48,7 @@ Jerry* createJerry(char* id, int happiness, Planet* planet, char* meimad) {
     jerry->his_origin = his_origin;
     jerry->his_physical = NULL;
     jerry->num_of_pyhshical = 0;
+    memset(&jerry->daycare_link, 0, sizeof(jerry->daycare_link)); // Not in the daycare list yet
 
     return jerry;
 }
@@ -78,6 +79,9 @@ PhysicalCharacteristics* createPhysicalCharacteristics(char* name, float value)
     // Set the value of the physical characteristic
     characteristics->value = value;
 
+    // The characteristic is not in any list of Jerries yet
+    characteristics->owner_node = NULL;
+
     // Return the pointer to the newly created PhysicalCharacteristics object
     return characteristics;
 }
@@ -3,6 +3,7 @@
 
 
 #include "Defs.h"
+#include "LinkedList.h"
 
 //planet struct contain name(str) and 3 cordination(float pointer)
 typedef struct {
@@ -19,19 +20,23 @@ typedef struct {
 } Origin;
 
 //PhysicalCharacteristics contains name(str pointer) and vlaue(float)
+//and owner_node(the node of the Jerry who has it in the list of Jerries with this characteristic, NULL if not listed)
 typedef struct {
     char *name;
     float value;
+    node owner_node;
 } PhysicalCharacteristics;
 
 //jerry struct contains id(str pointer) happines(int 0-100) his origin(origin pointer)
 //his pyhisical(an array of pointers to all his PhysicalCharacteristics) and num_of_pyhshical(how many phyisical he has)
+//and daycare_link(the links of the intrusive daycare list of Jerries, managed by that list)
 typedef struct {
     char *ID;
     int happines;
     Origin *his_origin;
     PhysicalCharacteristics **his_physical;
     int num_of_pyhshical;
+    ListLink daycare_link;
 } Jerry;
 
 
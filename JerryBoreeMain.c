@@ -4,18 +4,22 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stddef.h>
+#include <unistd.h>
 
 #include "Defs.h"
 #include "Jerry.h"               /* עבור פונקציות יצירה/הרס של Jerry, Planet וכו' */
 #include "LinkedList.h"
 #include "HashTable.h"
 #include "MultiValueHashTable.h"
+#include "WorkerPool.h"
 
 
 static LinkedList g_planetsList = NULL;       /* LinkedList של Planet* */
 static LinkedList g_jerriesList = NULL;       /* LinkedList של Jerry* */
 static hashTable g_jerriesHash = NULL;        /* key=ID(string), value=Jerry* */
 static hashTableProMax g_physicalHash = NULL; /* key=PhysicalName(string), value=LinkedList<Jerry*> */
+static int g_workerThreads = 1;               /* Threads used for full passes over a list (one per online CPU) */
 
 /* get functions*/
 LinkedList getPlanetsList()      { return g_planetsList; }
@@ -87,28 +91,6 @@ static bool compareStrings(Element e1, Element e2) {
 }
 
 
-/*
- * transformStringToNumber:
- * - Purpose: Converts a string into a numeric value, typically used as a transformation function for a hash table.
- * - Input Validation: If `key` is NULL, the function returns 0.
- * - Logic:
- *   - Iterates through each character in the string.
- *   - Adds the ASCII value of each character to the variable `sum`.
- *   - The final result is the sum of all ASCII values of the characters in the string.
- * - Stability: Casts each character to `unsigned char` to handle potential issues with negative values.
- * - Output: Returns the sum as an integer.
- */
-
-static int transformStringToNumber(Element key)
-{
-    if (!key) return 0;
-    int sum = 0;
-    const char* str = (const char*)key;
-    while (*str)
-        sum += (unsigned char)(*str++);
-    return sum;
-}
-
 /*
  * copyString:
  * - Purpose: Creates a duplicate of a string.
@@ -213,36 +195,169 @@ float get_abs(float x,float y) {
     return y - x;
 }
 
+/*
+ * ClosestMatch:
+ * - Partial result of `min_abs`: the closest Jerry found so far in one range of the list.
+ */
+typedef struct {
+    float distance;   /* Smallest |value - target| seen so far */
+    Jerry* chosen;    /* The Jerry it belongs to (NULL if none yet) */
+} ClosestMatch;
+
+/*
+ * ClosestQuery:
+ * - Context of `min_abs`: the characteristic to compare and the value Rick remembers.
+ */
+typedef struct {
+    char* physical;
+    float value;
+} ClosestQuery;
+
+/*
+ * accumulateClosest:
+ * - Purpose: Folds one Jerry into a `ClosestMatch` (accumulator for `parallelReduce`).
+ * - Logic: Skips Jerries without the characteristic; a Jerry replaces the current match only if it is strictly closer.
+ * - Output: `success`.
+ */
+static status accumulateClosest(Element partial, Element e, Element context)
+{
+    ClosestMatch* match = (ClosestMatch*)partial;
+    ClosestQuery* query = (ClosestQuery*)context;
+    Jerry* j = (Jerry*)e;
+    if (j && has_physical(*j, query->physical)) {
+        float distance = get_abs(get_value(j, query->physical), query->value);
+        if (distance < match->distance) {
+            match->distance = distance;
+            match->chosen = j;
+        }
+    }
+    return success;
+}
+
+/*
+ * combineClosest:
+ * - Purpose: Merges the match of a later range into the match of an earlier one (combiner for `parallelReduce`).
+ * - Logic: The later match wins only if it is strictly closer, so ties go to the Jerry that comes first, as in a single pass.
+ * - Output: `success`.
+ */
+static status combineClosest(Element partial, Element later, Element context)
+{
+    (void)context;
+    ClosestMatch* match = (ClosestMatch*)partial;
+    ClosestMatch* other = (ClosestMatch*)later;
+    if (other->distance < match->distance) {
+        *match = *other;
+    }
+    return success;
+}
+
 /*
  * min_abs:
  * - Purpose: Finds the `Jerry` object in a linked list with the closest physical characteristic value to the given `value`.
  * - Input Validation: Returns `NULL` if the linked list is empty.
  * - Logic:
- *   - Iterates over all nodes in the linked list.
+ *   - Reduces the list with `parallelReduce` (long lists are split over `g_workerThreads` threads).
  *   - Uses `has_physical` to check if the `Jerry` has the specified physical characteristic.
  *   - Computes the absolute difference between the characteristic value and the target `value`.
- *   - Tracks the minimum difference and selects the `Jerry` with the closest value.
+ *   - Tracks the minimum difference and selects the first `Jerry` with the closest value.
  * - Output: Pointer to the `Jerry` object with the closest characteristic value or `NULL` if no match is found.
  */
 Jerry* min_abs(LinkedList l,char* physical,float value) {
     if (!l) return NULL;
-    node current = getFirstElement(l);
-    float min = INFINITY;
-    Jerry* chosen = NULL;
-    while (current) {
-        if (get_data(current)) {
-            Jerry* j = (Jerry*)current;
-            if (has_physical(*j, (char*)physical)){
-                float jerry_val = get_value(j,physical);
-                if (get_abs(jerry_val,value) < min) {
-                    min = get_abs(jerry_val,value);
-                    chosen = j;
-                }
-            }
+    ClosestQuery query = {physical, value};
+    ClosestMatch matches[MAX_WORKER_THREADS];
+    Element partials[MAX_WORKER_THREADS];
+    for (int i = 0; i < g_workerThreads; i++) {
+        matches[i].distance = INFINITY;
+        matches[i].chosen = NULL;
+        partials[i] = &matches[i];
+    }
+    if (parallelReduce(l, accumulateClosest, combineClosest, &query, partials, g_workerThreads) == failure) {
+        return NULL;
+    }
+    return matches[0].chosen;
+}
+
+/*
+ * SaddestMatch:
+ * - Partial result of `find_saddest`: the least happy Jerry found so far in one range of the list.
+ */
+typedef struct {
+    int happiness;    /* Lowest happiness seen so far */
+    Jerry* chosen;    /* The Jerry it belongs to (NULL if none yet) */
+} SaddestMatch;
+
+/*
+ * accumulateSaddest:
+ * - Purpose: Folds one Jerry into a `SaddestMatch` (accumulator for `parallelReduce`).
+ * - Logic: A Jerry replaces the current match only if it is strictly less happy.
+ * - Output: `success`.
+ */
+static status accumulateSaddest(Element partial, Element e, Element context)
+{
+    (void)context;
+    SaddestMatch* match = (SaddestMatch*)partial;
+    Jerry* j = (Jerry*)e;
+    if (j && j->happines < match->happiness) {
+        match->happiness = j->happines;
+        match->chosen = j;
+    }
+    return success;
+}
+
+/*
+ * combineSaddest:
+ * - Purpose: Merges the match of a later range into the match of an earlier one (combiner for `parallelReduce`).
+ * - Logic: The later match wins only if it is strictly less happy, so ties go to the Jerry that comes first.
+ * - Output: `success`.
+ */
+static status combineSaddest(Element partial, Element later, Element context)
+{
+    (void)context;
+    SaddestMatch* match = (SaddestMatch*)partial;
+    SaddestMatch* other = (SaddestMatch*)later;
+    if (other->happiness < match->happiness) {
+        *match = *other;
+    }
+    return success;
+}
+
+/*
+ * find_saddest:
+ * - Purpose: Finds the `Jerry` with the lowest happiness in a linked list (option 6).
+ * - Logic: Reduces the list with `parallelReduce`; among equally sad Jerries the first one in the list is chosen.
+ * - Output: Pointer to the saddest `Jerry`, or `NULL` if the list is empty.
+ */
+Jerry* find_saddest(LinkedList l) {
+    if (!l) return NULL;
+    SaddestMatch matches[MAX_WORKER_THREADS];
+    Element partials[MAX_WORKER_THREADS];
+    for (int i = 0; i < g_workerThreads; i++) {
+        matches[i].happiness = 101; /* Above the maximum happiness, so any Jerry replaces it */
+        matches[i].chosen = NULL;
+        partials[i] = &matches[i];
+    }
+    if (parallelReduce(l, accumulateSaddest, combineSaddest, NULL, partials, g_workerThreads) == failure) {
+        return NULL;
+    }
+    return matches[0].chosen;
+}
+
+/*
+ * find_physical:
+ * - Purpose: Finds a physical characteristic of a `Jerry` by name.
+ * - Input Validation: Returns `NULL` if either input is `NULL`.
+ * - Logic: Scans the Jerry's characteristics and compares their names with `strcmp`.
+ * - Output: Pointer to the matching `PhysicalCharacteristics` or `NULL` if the Jerry does not have it.
+ */
+PhysicalCharacteristics* find_physical(Jerry* j, char* physical) {
+    if (!j || !physical) return NULL;
+    for (int i = 0; i < j->num_of_pyhshical; i++) {
+        if (strcmp(j->his_physical[i]->name, physical) == 0) {
+            return j->his_physical[i];
         }
-        current = getNextElement(l,current);
     }
-    return chosen;
+    return NULL;
 }
 
 /*
@@ -265,6 +380,59 @@ int min(int a,int b) {
     return a<b?a:b;
 }
 
+/*
+ * interactWithFakeBeth:
+ * - Purpose: Applies activity 1 of option 8 to a single Jerry (visitor for `parallelForEach`; it only touches that Jerry).
+ * - Logic: If happiness < 20 it drops by 5 (not below 0), otherwise it rises by 15 (not above 100).
+ * - Output: `success`, or `failure` if the element is NULL.
+ */
+static status interactWithFakeBeth(Element e, Element context)
+{
+    (void)context;
+    if (!e) return failure;
+    Jerry* j = (Jerry*)e;
+    if (j->happines < 20) {
+        j->happines = max(j->happines-5,0);
+    } else {
+        j->happines = min(j->happines+15,100);
+    }
+    return success;
+}
+
+/*
+ * playGolf:
+ * - Purpose: Applies activity 2 of option 8 to a single Jerry (visitor for `parallelForEach`; it only touches that Jerry).
+ * - Logic: If happiness < 50 it drops by 10 (not below 0), otherwise it rises by 10 (not above 100).
+ * - Output: `success`, or `failure` if the element is NULL.
+ */
+static status playGolf(Element e, Element context)
+{
+    (void)context;
+    if (!e) return failure;
+    Jerry* j = (Jerry*)e;
+    if (j->happines < 50) {
+        j->happines = max(j->happines-10,0);
+    } else {
+        j->happines = min(j->happines+10,100);
+    }
+    return success;
+}
+
+/*
+ * adjustTvPicture:
+ * - Purpose: Applies activity 3 of option 8 to a single Jerry (visitor for `parallelForEach`; it only touches that Jerry).
+ * - Logic: Happiness rises by 20, up to a maximum of 100.
+ * - Output: `success`, or `failure` if the element is NULL.
+ */
+static status adjustTvPicture(Element e, Element context)
+{
+    (void)context;
+    if (!e) return failure;
+    Jerry* j = (Jerry*)e;
+    j->happines = min(j->happines+20,100);
+    return success;
+}
+
 /*
  * hasPlanetName:
  * - Purpose: Checks if a `Planet` object matches a given name.
@@ -470,8 +638,9 @@ int nextPrime(int n) {
  * - Input Validation: Returns `failure` if the input `Jerry` is NULL.
  * - Logic:
  *   - Removes the `Jerry` from the global hash table of Jerries by ID.
- *   - Iterates through the `Jerry`'s physical characteristics and removes them from the physical hash table.
- *   - Removes the `Jerry` from the global linked list of Jerries.
+ *   - Iterates through the `Jerry`'s physical characteristics and removes them from the physical hash table
+ *     through the node handle each characteristic keeps (no list search).
+ *   - Removes the `Jerry` from the global linked list of Jerries through the links embedded in him (no list search).
  *   - Handles failures in each removal step.
  * - Output: `success` if all removals succeed; otherwise, `failure`.
  */
@@ -487,14 +656,14 @@ status delete_jerry(Jerry* j) {
 
 
     for (int i = 0; i < j->num_of_pyhshical; i++) {
-        char* physName = j->his_physical[i]->name;
-        if (removeFromHashTableProMax(g_physicalHash, physName, j) == failure) {
+        PhysicalCharacteristics* physical = j->his_physical[i];
+        if (removeHandleFromHashTableProMax(g_physicalHash, physical->name, physical->owner_node) == failure) {
 
         }
     }
 
 
-    if (deleteNode(g_jerriesList, j) == failure) {
+    if (deleteNodeByHandle(g_jerriesList, getElementNode(g_jerriesList, j)) == failure) {
 
         return failure;
     }
@@ -536,6 +705,8 @@ void destroyAll()
         destroyLinkedList(g_jerriesList); /* Frees the linked list of Jerry* */
         g_jerriesList = NULL;
     }
+
+    shutdownWorkerPool(); /* Joins the worker threads started by parallel passes */
 }
 /* ------------------------------------------------------------------
    הפונקציה המרכזית: readConfigAndBuild – קוראת את הקובץ ומבנה את המבנים
@@ -555,7 +726,7 @@ void destroyAll()
  *     2. **Initialization of Linked Lists**:
  *         - Initializes `g_planetsList` using `createLinkedList` with appropriate functions for freeing, comparing, and printing Planets.
  *             - If initialization fails, closes the file and returns `failure`.
- *         - Initializes `g_jerriesList` using `createLinkedList` with appropriate functions for freeing, comparing, and printing Jerries.
+ *         - Initializes `g_jerriesList` using `createIntrusiveLinkedList` (linked through each Jerry's `daycare_link`) with appropriate functions for freeing, comparing, and printing Jerries.
  *             - If initialization fails, destroys `g_planetsList`, closes the file, and returns `failure`.
  *     3. **Reading Configuration File**:
  *         - Sets up variables to track the current reading section (`readingPlanets`, `readingJerries`).
@@ -586,13 +757,13 @@ void destroyAll()
  *                     - Lines not starting with a tab indicate a new Jerry in the format `"id,dimension,planet,happiness"`.
  *                     - Parses `id`, `dimension`, `planetName`, and `happiness` using `sscanf`.
  *                     - Searches for the corresponding `Planet` in `g_planetsList` by comparing `planetName`.
- *                         - Iterates through `g_planetsList` using `getFirstElement` and `getNextElement`.
+ *                         - Iterates through `g_planetsList` with a `ListIterator`.
  *                         - If the `Planet` is not found, closes the file and returns `failure`.
  *                     - Creates an `Origin` object using `createOrigin` with the found `Planet` and `dimension`.
  *                         - If creation fails, closes the file, destroys all initialized structures, prints an error message, and returns `failure`.
  *                     - Creates a new `Jerry` object using `createJerry` with `id`, `happiness`, and the created `Origin`.
  *                         - If creation fails, destroys the `Origin`, closes the file, destroys all initialized structures, prints an error message, and returns `failure`.
- *                     - Appends the new `Jerry` to `g_jerriesList` using `appendNode`.
+ *                     - Appends the new `Jerry` to `g_jerriesList` using `appendNode` (the list links through his `daycare_link`, so nothing is allocated).
  *                         - If appending fails, destroys the created `Jerry`, closes the file, destroys all initialized structures, prints an error message, and returns `failure`.
  *                     - Updates `currentJerry` to point to the newly created `Jerry`.
  *                     - Increments `jerryCount`.
@@ -608,7 +779,7 @@ void destroyAll()
  *             - Creates the multi-value hash table using `createHashTableProMax` with appropriate functions for handling keys and values.
  *                 - Keys are physical characteristic names (`physName`), and values are lists of `Jerries` having that characteristic.
  *                 - If creation fails, destroys all initialized structures, prints an error message, and returns `failure`.
- *             - Iterates through each `Jerry` in `g_jerriesList` and adds them to `g_physicalHash` based on their physical characteristics using `addToHashTableProMax`.
+ *             - Iterates through each `Jerry` in `g_jerriesList` and adds them to `g_physicalHash` based on their physical characteristics using `addToHashTableProMaxWithHandle`, storing each handle in the characteristic's `owner_node`.
  *     6. **Final Output**:
  *         - Returns `success` if all operations complete without failures.
  * - Output:
@@ -634,7 +805,9 @@ status readConfigAndBuild(const char* fileName)
         return failure;
     }
 
-    g_jerriesList = createLinkedList(freeJerryPtr, compareJerries, printJerryPtr);
+    /* The Jerries list is intrusive: it links the Jerries through their `daycare_link`, so appends allocate nothing
+       and a Jerry can be removed in O(1) */
+    g_jerriesList = createIntrusiveLinkedList(freeJerryPtr, compareJerries, printJerryPtr, offsetof(Jerry, daycare_link));
     if (!g_jerriesList) {
         destroyLinkedList(g_planetsList);
         fclose(file);
@@ -738,14 +911,12 @@ status readConfigAndBuild(const char* fileName)
                 {
                     /* Locate the planet in the planets list */
                     Planet* pFound = NULL;
-                    Element el = getFirstElement(g_planetsList);
-                    while (el) {
-                        Planet* pCheck = (Planet*)el;
+                    for (ListIterator it = listBegin(g_planetsList); listIteratorValid(&it); listIteratorNext(&it)) {
+                        Planet* pCheck = (Planet*)listIteratorData(&it);
                         if (strcmp(pCheck->name, planetName) == 0) {
                             pFound = pCheck;
                             break;
                         }
-                        el = getNextElement(g_planetsList, el);
                     }
                     if (!pFound) {
                         // Error if planet not found
@@ -762,7 +933,7 @@ status readConfigAndBuild(const char* fileName)
                         return failure;
                     }
 
-                    /* Append Jerry to the list */
+                    /* Append Jerry to the list through his own links */
                     if (appendNode(g_jerriesList, j) == failure) {
                         destoyJerry(j);  // Free the Jerry if appending fails
                         fclose(file);
@@ -788,7 +959,8 @@ status readConfigAndBuild(const char* fileName)
      * Creates the hash table with appropriate functions for handling keys and values.
      */
     int l = getLength(g_jerriesList);
-    g_jerriesHash = createHashTable(
+    /* ID lookups are the hottest path, so this table uses the open-addressing backend */
+    g_jerriesHash = createHashTableWithBackend(
         copyString,            /* Key copying function (string) – shallow copy */
         freeStringPtr,         /* Key destruction function (string) */
         printStringPtr,        /* Key printing function (string) */
@@ -796,21 +968,21 @@ status readConfigAndBuild(const char* fileName)
         freeNoOp,              /* Value destruction function (no-op, managed by the list) */
         printJerryWrapper,     /* Value printing function – prints only Jerry ID */
         compareStrings,        /* Key comparison function */
-        transformStringToNumber, /* Transformation function */
-        nextPrime(l)           /* Hash table size */
+        hashString,            /* Transformation function (seeded string hash) */
+        nextPrime(l),          /* Expected number of entries (the table grows as needed) */
+        HASH_BACKEND_OPEN
     );
     if (!g_jerriesHash) return failure;
 
-    /* Insert all Jerries from the list into the hash table */
-    Element node = getFirstElement(g_jerriesList);
-    while (node) {
-        Jerry* j = (Jerry*)node;
-        if(addToHashTable(g_jerriesHash, j->ID, j)==failure) {
+    /* Insert all Jerries from the list into the hash table; the keys borrow j->ID, which the Jerry keeps
+     * until it is removed from the table (delete_jerry) or the table is destroyed (destroyAll) */
+    for (ListIterator it = listBegin(g_jerriesList); listIteratorValid(&it); listIteratorNext(&it)) {
+        Jerry* j = (Jerry*)listIteratorData(&it);
+        if(addToHashTableWithOwnership(g_jerriesHash, j->ID, j, HASH_OWNERSHIP_BORROW, HASH_OWNERSHIP_COPY)==failure) {
             destroyAll();
             printf("A memory problem has been detected in the program");
             return 1;
         }
-        node = getNextElement(g_jerriesList, node);
     }
 
     /* Physical Characteristics Hash Table (key: physical name, value: list of Jerries) */
@@ -827,7 +999,7 @@ status readConfigAndBuild(const char* fileName)
         printJerryWrapper,   /* printValue = displays the list */
         compareStrings,      /* Key comparison function (string) */
         compareStrings,      /* Value comparison function (not really used here) */
-        transformStringToNumber,
+        hashString,
         nextPrime(l)         /* Hash table size, can be adjusted */
     );
     if (!g_physicalHash) {
@@ -838,24 +1010,27 @@ status readConfigAndBuild(const char* fileName)
     }
 
     /* For each Jerry, for each physical characteristic => add to HashTableProMax */
-    node = getFirstElement(g_jerriesList);
-    while (node) {
-        Jerry* j = (Jerry*)node;
+    for (ListIterator it = listBegin(g_jerriesList); listIteratorValid(&it); listIteratorNext(&it)) {
+        Jerry* j = (Jerry*)listIteratorData(&it);
         for (int i = 0; i < j->num_of_pyhshical; i++) {
             /*
              * Ensure that the field name `his_physical` and `num_of_pyhshical`
              * correctly match the Jerry structure definition.
              */
-            char* physName = j->his_physical[i]->name;
-            if(addToHashTableProMax(g_physicalHash, physName, j)==failure) {
+            PhysicalCharacteristics* physical = j->his_physical[i];
+            if(addToHashTableProMaxWithHandle(g_physicalHash, physical->name, j, &physical->owner_node)==failure) {
                 destroyAll();
                 printf("A memory problem has been detected in the program");
                 return 1;
             }
         }
-        node = getNextElement(g_jerriesList, node);
     }
 
+    /* Many menu lookups are misses (a new ID, an unknown ID or characteristic), so both tables get a Bloom filter
+     * that answers those without reading the buckets; without one (out of memory) they just work as before */
+    enableHashTableFilter(g_jerriesHash);
+    enableHashTableProMaxFilter(g_physicalHash);
+
     return success;
 }
 
@@ -935,16 +1110,34 @@ int main(int argc, char* argv[]) {
     /* We pass argv[1] as the config file name. */
     // Here, the code calls runTest(argv[2]), which implies it expects a second argument beyond the config file.
     // However, we are NOT changing anything in the code; just noting that argv[2] is being used.
+    // Use one thread per online CPU for full passes over long lists.
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    g_workerThreads = cpus < 1 ? 1 : (cpus > MAX_WORKER_THREADS ? MAX_WORKER_THREADS : (int)cpus);
+
     if (runTest(argv[2]) == failure) {
         destroyAll();
         return 1;
     }
 
+    // With JERRYBOREE_HASH_STATS set (to a sampling period, 1 if not a number), the tables sample their lookups
+    // and their statistics are printed before every menu, to catch degenerate hashing while the daycare runs.
+    const char* statsPeriod = getenv("JERRYBOREE_HASH_STATS");
+    int samplePeriod = statsPeriod ? (atoi(statsPeriod) > 0 ? atoi(statsPeriod) : 1) : 0;
+    sampleHashTableLookups(g_jerriesHash, samplePeriod);
+    sampleHashTableProMaxLookups(g_physicalHash, samplePeriod);
+
     // A boolean flag to control the main loop of the program.
     bool done = false; // Flag to control the main program loop
 
     // Main loop that continues until 'done' becomes true.
     while (!done) {
+        if (samplePeriod > 0) {
+            printf("Jerries by ID :\n");
+            displayHashTableStats(g_jerriesHash);
+            printf("Jerries by physical characteristic :\n");
+            displayHashTableProMaxStats(g_physicalHash);
+        }
+
         // Print the main menu to the user.
         printMenu(); // Print the main menu for user options
 
@@ -970,8 +1163,9 @@ int main(int argc, char* argv[]) {
             // Remove trailing newline.
             id[strcspn(id, "\n")] = '\0';
 
-            // Check if a Jerry with this ID already exists in the Hash Table.
-            if(lookupInHashTable(g_jerriesHash,id)) {
+            // Check if a Jerry with this ID already exists in the Hash Table. Nothing is added before the new
+            // Jerry is fully built, so the table never holds an entry that points at this stack buffer.
+            if(lookupInHashTable(g_jerriesHash, id)) {
                 printf("Rick did you forgot ? you already left him here !\n");
             }
             else {
@@ -1015,8 +1209,10 @@ int main(int argc, char* argv[]) {
                         return 1;
                     }
 
-                    // Add the new Jerry to the Hash Table and LinkedList.
-                    if(addToHashTable(g_jerriesHash, j->ID, j)==failure) {
+                    // Add the new Jerry to the Hash Table (keyed by its own ID, like the loaded ones) and the LinkedList.
+                    if(addToHashTableWithOwnership(g_jerriesHash, j->ID, j, HASH_OWNERSHIP_BORROW,
+                                                   HASH_OWNERSHIP_COPY)==failure) {
+                        destoyJerry(j);
                         destroyAll();
                         printf("A memory problem has been detected in the program");
                         return 1;
@@ -1105,7 +1301,7 @@ int main(int argc, char* argv[]) {
                     }
 
                     // Update the specialized Hash Table that indexes by physical characteristic.
-                    if(addToHashTableProMax(g_physicalHash,characteristic,j)==failure) {
+                    if(addToHashTableProMaxWithHandle(g_physicalHash,characteristic,j,&physical->owner_node)==failure) {
                         destroyAll();
                         printf("A memory problem has been detected in the program");
                         return 1;
@@ -1159,8 +1355,10 @@ int main(int argc, char* argv[]) {
                     Jerry* j = searchByKeyInList(l, id, isJerryIDEqualWrapper);
                     if (j) {
                         // If found, remove this characteristic from the Jerry and update the list.
+                        // The node handle is read before the characteristic is destroyed.
+                        node handle = find_physical(j,characteristic)->owner_node;
                         delete_physical_from_jerry(j,characteristic);
-                        deleteNode(l,j);
+                        deleteNodeByHandle(l,handle);
                         printJerry(j);
                     } else {
                         printf("The information about his %s not available to the daycare !\n", characteristic);
@@ -1230,22 +1428,15 @@ int main(int argc, char* argv[]) {
 
         // If the user enters "6", we find the "saddest" Jerry (lowest happiness) and remove it from the daycare.
         } else if (strcmp(input, "6") == 0) {
-            int saddest = 101;
             // If there are no Jerries in the daycare, we cannot proceed.
             if (!getFirstElement(g_jerriesList)) {
                 printf("Rick we can not help you - we currently have no Jerries in the daycare !\n");
             }
             else {
-                // Traverse the list to find the Jerry with the lowest happiness.
-                Jerry* current = getFirstElement(g_jerriesList);
-                Jerry* j = current;
-                while (current) {
-                    if (current->happines < saddest) {
-                        j = current;
-                        saddest = current->happines;
-                    }
-                    current = getNextElement(g_jerriesList, current);
-                }
+                // Reduce the list to the Jerry with the lowest happiness.
+                // The reduce's workers only read the Jerries of the list: g_jerriesHash is a plain hashTable, not
+                // the thread-safe concurrentHashTable, so only this thread may touch it (delete_jerry, once they joined).
+                Jerry* j = find_saddest(g_jerriesList);
                 if(j) {
                     printf("Rick this is the most suitable Jerry we found :\n");
                     printJerry(j);
@@ -1326,6 +1517,8 @@ int main(int argc, char* argv[]) {
 
         // If the user enters "8", we perform an activity that modifies the happiness of all Jerries.
         } else if (strcmp(input, "8") == 0) {
+            // The activities run on the worker threads, and each visitor only changes the happiness of its own Jerry.
+            // They must never touch g_jerriesHash: it is a plain hashTable, not the thread-safe concurrentHashTable.
             // If we have no Jerries, we cannot run an activity.
             if (getLength(g_jerriesList) == 0) {
                 printf("Rick we can not help you - we currently have no Jerries in the daycare !\n");
@@ -1347,21 +1540,9 @@ int main(int argc, char* argv[]) {
 
                 // Activity "1": Interact with fake Beth.
                 if (strcmp(userInput, "1") == 0) {
-                    Jerry* current = getFirstElement(g_jerriesList);
-                    // For each Jerry:
-                    while (current) {
-                        Jerry* j = current;
-                        if (j) {
-                            // If happiness < 20, reduce it by 5 (but not below 0).
-                            // Otherwise, increase it by 15 (but not above 100).
-                            if (j->happines < 20) {
-                                j->happines = max(j->happines-5,0);
-                            } else {
-                                j->happines = min(j->happines+15,100);
-                            }
-                        }
-                        current = getNextElement(g_jerriesList, current);
-                    }
+                    // For each Jerry: if happiness < 20, reduce it by 5 (but not below 0).
+                    // Otherwise, increase it by 15 (but not above 100).
+                    parallelForEach(g_jerriesList, interactWithFakeBeth, NULL, g_workerThreads);
                     printf("The activity is now over !\n");
                     if(displayList(g_jerriesList)==failure) {
                         destroyAll();
@@ -1371,19 +1552,8 @@ int main(int argc, char* argv[]) {
 
                 // Activity "2": Play golf.
                 } else if (strcmp(userInput, "2") == 0) {
-                    Jerry* current = getFirstElement(g_jerriesList);
-                    while (current) {
-                        Jerry* j = current;
-                        if (j) {
-                            // If happiness < 50, reduce by 10. Otherwise, increase by 10.
-                            if (j->happines < 50) {
-                                j->happines = max(j->happines-10,0);
-                            } else {
-                                j->happines = min(j->happines+10,100);
-                            }
-                        }
-                        current = getNextElement(g_jerriesList, current);
-                    }
+                    // If happiness < 50, reduce by 10. Otherwise, increase by 10.
+                    parallelForEach(g_jerriesList, playGolf, NULL, g_workerThreads);
                     printf("The activity is now over !\n");
                     if(displayList(g_jerriesList)==failure) {
                         destroyAll();
@@ -1393,15 +1563,8 @@ int main(int argc, char* argv[]) {
 
                 // Activity "3": Adjust the TV's picture settings.
                 } else if (strcmp(userInput, "3") == 0) {
-                    Jerry* current = getFirstElement(g_jerriesList);
-                    while (current) {
-                        Jerry* j = current;
-                        if (j) {
-                            // Increase happiness by 20, up to a maximum of 100.
-                            j->happines = min(j->happines+20,100);
-                        }
-                        current = getNextElement(g_jerriesList, current);
-                    }
+                    // Increase happiness by 20, up to a maximum of 100.
+                    parallelForEach(g_jerriesList, adjustTvPicture, NULL, g_workerThreads);
                     printf("The activity is now over !\n");
                     if(displayList(g_jerriesList)==failure) {
                         destroyAll();
@@ -1,31 +1,32 @@
 #include "KeyValuePair.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+
+#define KEY_BORROWED_BIT ((uintptr_t)1) // Lowest bit of `link`: the key is borrowed (pairs are at least 2-byte aligned)
 
 struct KeyAndValuePair {
-    Element key;                 // The key element of the pair
-    Element value;               // The value element of the pair
-    FreeFunction free_key;       // Function pointer to free the memory of the key
-    FreeFunction free_value;     // Function pointer to free the memory of the value
-    PrintFunction print_key;     // Function pointer to print the key
-    PrintFunction print_value;   // Function pointer to print the value
-    EqualFunction compare_key;   // Function pointer to compare keys
+    Element key;                        // The key element of the pair
+    Element value;                      // The value element of the pair
+    unsigned long long keyHash;         // Full hash of the key, cached by the hash table holding the pair
+    uintptr_t link;                     // Next pair in the container's chain, plus KEY_BORROWED_BIT
 };
 
 
-KeyValuePair createKeyValuePair(Element key, Element value,
-                                FreeFunction free_key, FreeFunction free_value,
-                                PrintFunction print_key, PrintFunction print_value,
-                                EqualFunction compare_key)
+KeyValuePair createKeyValuePair(Element key, Element value, const KeyValueFunctions* functions)
 {
     // Validate input parameters
-    if (!key || !value || !free_key || !free_value || !print_key || !print_value || !compare_key) {
-        // If any parameter is NULL, free allocated resources and return NULL
+    if (!functions || !functions->free_key || !functions->free_value || !functions->print_key ||
+        !functions->print_value || !functions->compare_key) {
+        return NULL; // Without its callbacks the pair could not release the key and value
+    }
+    if (!key || !value) {
+        // If the key or value is NULL, free allocated resources and return NULL
         if (key) {
-            free_key(key); // Free the allocated key if it's valid
+            functions->free_key(key); // Free the allocated key if it's valid
         }
         if (value) {
-            free_value(value); // Free the allocated value if it's valid
+            functions->free_value(value); // Free the allocated value if it's valid
         }
         return NULL; // Return NULL indicating failure
     }
@@ -34,33 +35,30 @@ KeyValuePair createKeyValuePair(Element key, Element value,
     KeyValuePair pair = (KeyValuePair)malloc(sizeof(*pair));
     if (!pair) { // Check if memory allocation failed
         // If allocation fails, free the key and value to prevent memory leaks
-        free_key(key);
-        free_value(value);
+        functions->free_key(key);
+        functions->free_value(value);
         return NULL; // Return NULL indicating failure
     }
 
     // Initialize the fields of the KeyValuePair
     pair->key = key;                // Assign the key to the pair
     pair->value = value;            // Assign the value to the pair
-    pair->free_key = free_key;      // Assign the key's free function
-    pair->free_value = free_value;  // Assign the value's free function
-    pair->print_key = print_key;    // Assign the key's print function
-    pair->print_value = print_value;// Assign the value's print function
-    pair->compare_key = compare_key;// Assign the key comparison function
+    pair->keyHash = 0;              // No hash cached yet
+    pair->link = 0;                 // Not chained yet, and the key is owned
 
     return pair; // Return the newly created KeyValuePair
 }
 
 
-status destroyKeyValuePair(KeyValuePair pair) {
-    // Check if the KeyValuePair is NULL
-    if (!pair) return failure; // Return failure if the pair is invalid
+status destroyKeyValuePair(KeyValuePair pair, const KeyValueFunctions* functions) {
+    // Check if the KeyValuePair or its callbacks are NULL
+    if (!pair || !functions) return failure; // Return failure if the pair is invalid
 
-    // Free the key if the free_key function is provided
-    if (pair->free_key) pair->free_key(pair->key);
+    // Free the key if the free_key function is provided and the key is not borrowed
+    if (functions->free_key && !(pair->link & KEY_BORROWED_BIT)) functions->free_key(pair->key);
 
     // Free the value if the free_value function is provided
-    if (pair->free_value) pair->free_value(pair->value);
+    if (functions->free_value) functions->free_value(pair->value);
 
     // Free the memory allocated for the KeyValuePair structure itself
     free(pair);
@@ -69,38 +67,38 @@ status destroyKeyValuePair(KeyValuePair pair) {
 }
 
 
-status displayKey(KeyValuePair pair) {
+status displayKey(KeyValuePair pair, const KeyValueFunctions* functions) {
     // Check if the KeyValuePair or the print_key function is NULL
-    if (!pair || !pair->print_key) return failure; // Return failure if the pair or the print function is invalid
+    if (!pair || !functions || !functions->print_key) return failure; // Return failure if the pair or the print function is invalid
 
     // Call the print_key function to display the key
-    pair->print_key(pair->key);
+    functions->print_key(pair->key);
 
     return success; // Return success to indicate the key was displayed successfully
 }
 
 
-status displayValue(KeyValuePair pair) {
+status displayValue(KeyValuePair pair, const KeyValueFunctions* functions) {
     // Check if the KeyValuePair or the print_value function is NULL
-    if (!pair || !pair->print_value) return failure; // Return failure if the pair or the print function is invalid
+    if (!pair || !functions || !functions->print_value) return failure; // Return failure if the pair or the print function is invalid
 
     // Call the print_value function to display the value
-    pair->print_value(pair->value);
+    functions->print_value(pair->value);
 
     return success; // Return success to indicate the value was displayed successfully
 }
 
 
-status displayKeyValue(KeyValuePair pair) {
+status displayKeyValue(KeyValuePair pair, const KeyValueFunctions* functions) {
     // Check if the KeyValuePair or its print functions (key and value) are NULL
-    if (!pair || !pair->print_key || !pair->print_value) return failure;
+    if (!pair || !functions || !functions->print_key || !functions->print_value) return failure;
     // Return failure if the pair or either print function is invalid
 
     // Call the print_key function to display the key
-    pair->print_key(pair->key);
+    functions->print_key(pair->key);
 
     // Call the print_value function to display the value
-    pair->print_value(pair->value);
+    functions->print_value(pair->value);
 
     return success; // Return success to indicate both key and value were displayed successfully
 }
@@ -120,7 +118,51 @@ Element getValue(KeyValuePair pair) {
 }
 
 
-bool isEqualKey(KeyValuePair pair, Element key) {
-    if (!pair || !key || !pair->compare_key) return false;
-    return pair->compare_key(pair->key, key);
+Element* getValueSlot(KeyValuePair pair) {
+    // Return where the pair stores its value, so the owner can replace it in place
+    return (pair) ? &pair->value : NULL;
+}
+
+
+status setKeyBorrowed(KeyValuePair pair, bool borrowed) {
+    if (!pair) return failure;
+    pair->link = borrowed ? (pair->link | KEY_BORROWED_BIT) : (pair->link & ~KEY_BORROWED_BIT);
+    return success;
+}
+
+
+bool isKeyBorrowed(KeyValuePair pair) {
+    return (pair && (pair->link & KEY_BORROWED_BIT)) ? true : false;
+}
+
+
+bool isEqualKey(KeyValuePair pair, Element key, const KeyValueFunctions* functions) {
+    if (!pair || !key || !functions || !functions->compare_key) return false;
+    return functions->compare_key(pair->key, key);
+}
+
+
+status setKeyHash(KeyValuePair pair, unsigned long long hash) {
+    if (!pair) return failure;
+    pair->keyHash = hash; // Remember the hash so the key never needs rehashing
+    return success;
+}
+
+
+unsigned long long getKeyHash(KeyValuePair pair) {
+    // Return the cached hash, or 0 if the pair is invalid
+    return (pair) ? pair->keyHash : 0;
+}
+
+
+KeyValuePair getNextPair(KeyValuePair pair) {
+    // Return the next pair of the chain without the flag bit, or NULL if the pair is invalid
+    return (pair) ? (KeyValuePair)(pair->link & ~KEY_BORROWED_BIT) : NULL;
+}
+
+
+status setNextPair(KeyValuePair pair, KeyValuePair next) {
+    if (!pair) return failure;
+    pair->link = (uintptr_t)next | (pair->link & KEY_BORROWED_BIT); // Link the pair to its successor, keeping the flag
+    return success;
 }
@@ -9,34 +9,43 @@
 // Define KeyValuePair as a pointer to a KeyAndValuePair structure
 typedef struct KeyAndValuePair *KeyValuePair;
 
+// Callbacks of key-value pairs, kept once by the container that owns the pairs and passed in by it,
+// so a pair holds nothing but its key, value, cached hash and chain link
+typedef struct Key_Value_Functions {
+    FreeFunction free_key;     // Function to free the key
+    FreeFunction free_value;   // Function to free the value
+    PrintFunction print_key;   // Function to print the key
+    PrintFunction print_value; // Function to print the value
+    EqualFunction compare_key; // Function to compare keys
+} KeyValueFunctions;
+
 // Function to create a KeyValuePair structure
+// If the pair cannot be created, the key and value are freed with the given functions
 // key: The key element of the pair
 // value: The value element of the pair
-// free_key: Function to free the key
-// free_value: Function to free the value
-// print_key: Function to print the key
-// print_value: Function to print the value
-// compare_key: Function to compare keys
-KeyValuePair createKeyValuePair(Element key, Element value,
-                                 FreeFunction free_key, FreeFunction free_value,
-                                 PrintFunction print_key, PrintFunction print_value,
-                                 EqualFunction compare_key);
+// functions: The callbacks of the container; the pair does not keep them
+KeyValuePair createKeyValuePair(Element key, Element value, const KeyValueFunctions* functions);
 
 // Function to destroy a KeyValuePair structure
+// The key is not freed if the pair was marked with setKeyBorrowed
 // pair: The KeyValuePair to be destroyed
-status destroyKeyValuePair(KeyValuePair pair);
+// functions: The callbacks of the container that owns the pair
+status destroyKeyValuePair(KeyValuePair pair, const KeyValueFunctions* functions);
 
 // Function to display the key of a KeyValuePair
 // pair: The KeyValuePair whose key is to be displayed
-status displayKey(KeyValuePair pair);
+// functions: The callbacks of the container that owns the pair
+status displayKey(KeyValuePair pair, const KeyValueFunctions* functions);
 
 // Function to display the value of a KeyValuePair
 // pair: The KeyValuePair whose value is to be displayed
-status displayValue(KeyValuePair pair);
+// functions: The callbacks of the container that owns the pair
+status displayValue(KeyValuePair pair, const KeyValueFunctions* functions);
 
 // Function to display both the key and value of a KeyValuePair
 // pair: The KeyValuePair whose key and value are to be displayed
-status displayKeyValue(KeyValuePair pair);
+// functions: The callbacks of the container that owns the pair
+status displayKeyValue(KeyValuePair pair, const KeyValueFunctions* functions);
 
 // Function to retrieve the key from a KeyValuePair
 // pair: The KeyValuePair whose key is to be retrieved
@@ -48,11 +57,49 @@ Element getKey(KeyValuePair pair);
 // Returns: The value element of the pair
 Element getValue(KeyValuePair pair);
 
+// Function to retrieve the address of the value stored in a KeyValuePair
+// pair: The KeyValuePair whose value slot is to be retrieved
+// Returns: The address of the value, valid while the pair exists, or NULL if the pair is invalid
+Element* getValueSlot(KeyValuePair pair);
+
+// Function to mark the key of a KeyValuePair as borrowed: destroyKeyValuePair then leaves it to its owner
+// pair: The KeyValuePair whose key is borrowed
+// borrowed: true if the key must not be freed with the pair
+status setKeyBorrowed(KeyValuePair pair, bool borrowed);
+
+// Function to check whether the key of a KeyValuePair is borrowed
+// pair: The KeyValuePair to check
+// Returns: true if setKeyBorrowed marked the key as borrowed, false otherwise
+bool isKeyBorrowed(KeyValuePair pair);
+
 // Function to check if a given key is equal to the key in a KeyValuePair
 // pair: The KeyValuePair to check against
 // key: The key to compare
+// functions: The callbacks of the container that owns the pair
 // Returns: true if the keys are equal, false otherwise
-bool isEqualKey(KeyValuePair pair, Element key);
+bool isEqualKey(KeyValuePair pair, Element key, const KeyValueFunctions* functions);
+
+// Function to cache the full hash of the pair's key (0 until set)
+// Lets a hash table skip comparing keys whose hashes differ, and resize without hashing the key again
+// pair: The KeyValuePair whose key hash is stored
+// hash: The hash of the key
+status setKeyHash(KeyValuePair pair, unsigned long long hash);
+
+// Function to retrieve the hash cached with setKeyHash
+// pair: The KeyValuePair whose key hash is to be retrieved
+// Returns: The cached hash, or 0 if none was set
+unsigned long long getKeyHash(KeyValuePair pair);
+
+// Function to retrieve the pair that follows this one in its chain
+// A container (such as a hash table bucket) chains its pairs through the pairs themselves instead of a separate list
+// pair: The KeyValuePair whose successor is to be retrieved
+// Returns: The next pair, or NULL at the end of the chain or if the pair is invalid
+KeyValuePair getNextPair(KeyValuePair pair);
+
+// Function to set the pair that follows this one in its chain (a new pair starts with none)
+// pair: The KeyValuePair whose successor is set
+// next: The pair that follows it, or NULL to end the chain there
+status setNextPair(KeyValuePair pair, KeyValuePair next);
 
 
 #endif // KEY_VALUE_PAIR_H
@@ -5,6 +5,8 @@
 #include <string.h>
 #include <stdio.h>
 #include "LinkedList.h"
+#include "MemoryPool.h"
+#include "WorkerPool.h"
 
 // Definition of the Node structure
 struct Node {
@@ -12,18 +14,62 @@ struct Node {
     struct Node* next;     // Pointer to the next node in the linked list
 };
 
+// Definition of the node used by the doubly linked layout
+struct Double_Node {
+    struct Node base;      // Element and next pointer, laid out exactly like a single node
+    node prev;             // Pointer to the previous node in the linked list
+};
+
+// The intrusive layout uses a ListLink inside each element as its Double_Node
+_Static_assert(sizeof(ListLink) == sizeof(struct Double_Node), "ListLink must be able to hold a Double_Node");
+
+// Definition of the node used by the unrolled layout (128 bytes on 64-bit systems)
+struct Unrolled_Node {
+    struct Unrolled_Node* next;                 // Pointer to the next block in the linked list
+    int count;                                  // Number of elements currently stored in this block
+    Element elements[UNROLLED_NODE_CAPACITY];   // The elements, in list order, packed at the front
+};
+
+typedef struct Unrolled_Node* block;   // Defines block as a pointer to an Unrolled_Node structure
+
+// Distance (in nodes) between two consecutive entries of the skip index used by getDataByIndex
+#define SKIP_INDEX_STRIDE 64
+
 // Definition of the Linked_List structure
 struct Linked_List {
     node tail;             // Pointer to the last node in the linked list
     node head;             // Pointer to the first node in the linked list
+    block firstBlock;      // Pointer to the first block (unrolled layout only)
+    block lastBlock;       // Pointer to the last block (unrolled layout only)
+    ListLayout layout;     // How the elements are stored (single nodes, double nodes, unrolled blocks, or intrusive links)
+    size_t linkOffset;     // Offset of the ListLink inside every element (intrusive layout only)
     int size;              // The number of elements in the linked list
     FreeFunction free_Func;  // Function pointer for freeing the memory of elements
     EqualFunction compare_func; // Function pointer for comparing two elements
     PrintFunction print_func;   // Function pointer for printing an element
+    MemoryPool nodes;      // Slab pool the nodes are allocated from (created on the first append)
+    node finger;           // Node returned by the last getDataByIndex call (single and double layouts)
+    block fingerBlock;     // Block holding that element (unrolled layout)
+    int fingerPosition;    // Zero-based position of finger, or of the first element of fingerBlock; -1 if unset
+    node* skipIndex;       // skipIndex[k] is the node at position k * SKIP_INDEX_STRIDE
+    int skipValid;         // Number of leading skipIndex entries that are up to date
+    int skipCapacity;      // Number of entries allocated for skipIndex
 };
 
 
 LinkedList createLinkedList(FreeFunction free_func, EqualFunction compare_func, PrintFunction print_func) {
+    // A plain linked list stores one element per node
+    return createLinkedListWithLayout(free_func, compare_func, print_func, LIST_LAYOUT_SINGLE);
+}
+
+
+LinkedList createLinkedListWithLayout(FreeFunction free_func, EqualFunction compare_func, PrintFunction print_func,
+                                      ListLayout layout) {
+    // Check that the layout is one of the supported layouts
+    if (layout != LIST_LAYOUT_SINGLE && layout != LIST_LAYOUT_DOUBLE && layout != LIST_LAYOUT_UNROLLED) {
+        return NULL; // Return NULL for an unknown layout
+    }
+
     // Allocate memory for a new Linked_List structure
     LinkedList list = (LinkedList)malloc(sizeof(struct Linked_List));
     if (!list) { // Check if memory allocation failed
@@ -39,46 +85,286 @@ LinkedList createLinkedList(FreeFunction free_func, EqualFunction compare_func,
     list->size = 0;   // Set the size of the list to 0 (empty list)
     list->head = NULL; // Set the head pointer to NULL (no nodes yet)
     list->tail = NULL; // Set the tail pointer to NULL (no nodes yet)
+    list->firstBlock = NULL; // No blocks yet (unrolled layout)
+    list->lastBlock = NULL;
+    list->layout = layout; // Remember how the elements are stored
+    list->linkOffset = 0;
+    list->finger = NULL;   // No indexed access yet, so there is no finger and no skip index
+    list->fingerBlock = NULL;
+    list->fingerPosition = -1;
+    list->skipIndex = NULL;
+    list->skipValid = 0;
+    list->skipCapacity = 0;
+    list->nodes = NULL; // The node pool is created lazily, so empty lists cost a single allocation
 
     return list; // Return the newly created and initialized linked list
 }
 
 
+/*
+ * nodeSizeFor:
+ * The size of the nodes a layout allocates from its pool.
+ */
+static size_t nodeSizeFor(ListLayout layout) {
+    if (layout == LIST_LAYOUT_UNROLLED) {
+        return sizeof(struct Unrolled_Node);
+    }
+    return layout == LIST_LAYOUT_DOUBLE ? sizeof(struct Double_Node) : sizeof(struct Node);
+}
+
+
+MemoryPool createListNodePool(ListLayout layout) {
+    // Check that the layout is one whose nodes come from a pool
+    if (layout != LIST_LAYOUT_SINGLE && layout != LIST_LAYOUT_DOUBLE && layout != LIST_LAYOUT_UNROLLED) {
+        return NULL;
+    }
+    return createMemoryPool(nodeSizeFor(layout));
+}
+
+
+LinkedList createLinkedListInPool(FreeFunction free_func, EqualFunction compare_func, PrintFunction print_func,
+                                  ListLayout layout, MemoryPool pool) {
+    // Check that there is a pool to share
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    LinkedList list = createLinkedListWithLayout(free_func, compare_func, print_func, layout);
+    if (list == NULL) {
+        return NULL; // Return NULL if memory allocation failed
+    }
+    list->nodes = shareMemoryPool(pool); // Register the list as one more user instead of creating a pool
+    return list;
+}
+
+
+LinkedList createIntrusiveLinkedList(FreeFunction free_func, EqualFunction compare_func, PrintFunction print_func,
+                                     size_t linkOffset) {
+    // An intrusive list works like a doubly linked one whose nodes are the links inside the elements
+    LinkedList list = createLinkedListWithLayout(free_func, compare_func, print_func, LIST_LAYOUT_DOUBLE);
+    if (list == NULL) {
+        return NULL; // Return NULL if memory allocation failed
+    }
+    list->layout = LIST_LAYOUT_INTRUSIVE;
+    list->linkOffset = linkOffset;
+    return list;
+}
+
+
+/*
+ * hasBackLinks:
+ * Tells whether the nodes of a list are doubly linked (double and intrusive layouts).
+ */
+static bool hasBackLinks(LinkedList list) {
+    return (list->layout == LIST_LAYOUT_DOUBLE || list->layout == LIST_LAYOUT_INTRUSIVE) ? true : false;
+}
+
+
+/*
+ * appendToBlocks:
+ * Appends an element to a list with the unrolled layout.
+ * The element goes into the last block if it has room; otherwise a new block is taken from the pool.
+ */
+static status appendToBlocks(LinkedList list, Element element) {
+    block last = list->lastBlock;
+
+    // Start a new block if there is none yet or the last one is full
+    if (last == NULL || last->count == UNROLLED_NODE_CAPACITY) {
+        block new_block = (block)allocateFromPool(list->nodes);
+        if (new_block == NULL) { // Check if memory allocation failed
+            return failure;
+        }
+        new_block->next = NULL;
+        new_block->count = 0;
+
+        // Link the new block after the current last block
+        if (last == NULL) {
+            list->firstBlock = new_block;
+        } else {
+            last->next = new_block;
+        }
+        list->lastBlock = new_block;
+        last = new_block;
+    }
+
+    last->elements[last->count++] = element; // Store the element right after the block's current elements
+    list->size++;
+    return success;
+}
+
+
+/*
+ * deleteFromBlocks:
+ * Deletes the first element matching `element` from a list with the unrolled layout.
+ * The remaining elements of the block are shifted to keep list order; an emptied block is unlinked,
+ * and a block that drops below half full absorbs its successor when both fit in one block.
+ */
+static status deleteFromBlocks(LinkedList list, Element element) {
+    block previous = NULL;
+
+    for (block b = list->firstBlock; b != NULL; previous = b, b = b->next) {
+        for (int i = 0; i < b->count; i++) {
+            if (!list->compare_func(element, b->elements[i])) {
+                continue; // Not the element we are looking for
+            }
+
+            // Blocks may shift, merge or disappear below, so forget the indexed-access finger
+            list->fingerBlock = NULL;
+            list->fingerPosition = -1;
+
+            // Free the element and close the gap it leaves in the block
+            list->free_Func(b->elements[i]);
+            memmove(&b->elements[i], &b->elements[i + 1], (size_t)(b->count - i - 1) * sizeof(Element));
+            b->count--;
+            list->size--;
+
+            if (b->count == 0) {
+                // Unlink the empty block and give it back to the pool
+                if (previous == NULL) {
+                    list->firstBlock = b->next;
+                } else {
+                    previous->next = b->next;
+                }
+                if (b == list->lastBlock) {
+                    list->lastBlock = previous;
+                }
+                releaseToPool(list->nodes, b);
+            } else if (b->count < UNROLLED_NODE_CAPACITY / 2 && b->next != NULL &&
+                       b->count + b->next->count <= UNROLLED_NODE_CAPACITY) {
+                // Merge the following block into this one so blocks stay densely packed
+                block victim = b->next;
+                memcpy(&b->elements[b->count], victim->elements, (size_t)victim->count * sizeof(Element));
+                b->count += victim->count;
+                b->next = victim->next;
+                if (victim == list->lastBlock) {
+                    list->lastBlock = b;
+                }
+                releaseToPool(list->nodes, victim);
+            }
+
+            return success; // Return success after deleting the element
+        }
+    }
+
+    // If the element was not found, return failure
+    return failure;
+}
+
+
 status destroyLinkedList(LinkedList list) {
     // Check if the list or the free function is NULL
     if (list == NULL || list->free_Func == NULL) {
         return failure; // Return failure if the list or free function is not initialized
     }
 
+    // Nodes go back to the pool one by one, so other lists sharing it can reuse them
+    // (an intrusive node is part of its element and goes away with it)
     node current = list->head; // Start with the head of the linked list
     while (current != NULL) { // Loop through all nodes in the list
         node next = current->next; // Save the pointer to the next node
-        list->free_Func(current->element); // Free the memory of the element stored in the current node
-        free(current); // Free the current node
+        Element element = current->element;
+        if (list->layout != LIST_LAYOUT_INTRUSIVE) {
+            releaseToPool(list->nodes, current);
+        }
+        list->free_Func(element); // Free the memory of the element stored in the current node
         current = next; // Move to the next node
     }
 
+    // In the unrolled layout the elements sit side by side inside each block
+    block b = list->firstBlock;
+    while (b != NULL) {
+        block next = b->next;
+        for (int i = 0; i < b->count; i++) {
+            list->free_Func(b->elements[i]); // Free every element stored in the block
+        }
+        releaseToPool(list->nodes, b);
+        b = next;
+    }
+
+    // Drop the list's use of the pool; its last user hands every slab back to the system at once
+    if (list->nodes != NULL) {
+        destroyMemoryPool(list->nodes);
+    }
+
+    free(list->skipIndex); // Free the skip index used by getDataByIndex (NULL if it was never built)
+
     free(list); // Free the memory allocated for the linked list structure itself
     return success; // Return success to indicate the list was successfully destroyed
 }
 
 
-status appendNode(LinkedList list, Element element) {
-    // Check if the list or its required functions are NULL
-    if (list == NULL || list->free_Func == NULL || list->compare_func == NULL) {
-        return failure; // Return failure if the list or functions are not properly initialized
+/*
+ * shiftSkipEntriesFrom:
+ * Called before a node is unlinked: skip index entries `first` and up describe positions at or after it,
+ * so each moves one node on (entries past the new end of the list are dropped). Entries before stay as they are,
+ * so the index is never rebuilt from the head after a deletion.
+ */
+static void shiftSkipEntriesFrom(LinkedList list, int first) {
+    for (int k = first; k < list->skipValid; k++) {
+        list->skipIndex[k] = list->skipIndex[k]->next;
+        if (list->skipIndex[k] == NULL) {
+            list->skipValid = k; // The entry was the tail, so its position no longer exists
+            return;
+        }
+    }
+}
+
+
+/*
+ * forgetPositionsFrom:
+ * Keeps the indexed-access state valid when the node at zero-based `position` is about to be deleted.
+ * Skip index entries before the position stay valid and the later ones move on; a finger after it moves one position down.
+ */
+static void forgetPositionsFrom(LinkedList list, int position) {
+    // Entry k describes position k * SKIP_INDEX_STRIDE, so the entries from `position` on shift
+    shiftSkipEntriesFrom(list, (position + SKIP_INDEX_STRIDE - 1) / SKIP_INDEX_STRIDE);
+
+    if (list->fingerPosition == position) {
+        list->finger = NULL; // The finger's node is the one being deleted
+        list->fingerPosition = -1;
+    } else if (list->fingerPosition > position) {
+        list->fingerPosition--; // Same node, one position closer to the head
+    }
+}
+
+
+/*
+ * prepareNodePool:
+ * Creates the list's node pool on the first append, sized for the kind of node its layout uses.
+ */
+static status prepareNodePool(LinkedList list) {
+    if (list->nodes != NULL || list->layout == LIST_LAYOUT_INTRUSIVE) {
+        return success; // The pool already exists, or the nodes live inside the elements
     }
 
-    // Allocate memory for a new node
-    node new_node = (node)malloc(sizeof(struct Node));
+    list->nodes = createMemoryPool(nodeSizeFor(list->layout));
+    return list->nodes != NULL ? success : failure; // Fail if memory allocation failed
+}
+
+
+/*
+ * linkNewNode:
+ * Takes a node from the pool, stores the element in it and links it after the current tail.
+ * Returns the new node, or NULL if memory allocation failed.
+ */
+static node linkNewNode(LinkedList list, Element element) {
+    // Take a node from the pool (reuses deleted nodes, so steady-state appends do not call malloc);
+    // an intrusive list uses the link embedded in the element instead
+    node new_node = list->layout == LIST_LAYOUT_INTRUSIVE ? (node)((char*)element + list->linkOffset)
+                                                          : (node)allocateFromPool(list->nodes);
     if (new_node == NULL) { // Check if memory allocation failed
-        return failure; // Return failure if the node could not be created
+        return NULL; // Return NULL if the node could not be created
     }
 
     // Initialize the new node with the given element and set its next pointer to NULL
     new_node->element = element;
     new_node->next = NULL;
 
+    // In the doubly linked layouts the new node also points back at the old tail
+    if (hasBackLinks(list)) {
+        ((struct Double_Node*)new_node)->prev = list->tail;
+    }
+
     // If the list is empty, set the new node as both the head and the tail
     if (list->size == 0) {
         list->head = new_node; // Set the head to the new node
@@ -92,7 +378,137 @@ status appendNode(LinkedList list, Element element) {
     // Increment the size of the list
     list->size++;
 
-    return success; // Return success to indicate the node was appended
+    return new_node;
+}
+
+
+/*
+ * unlinkNode:
+ * Removes `current` from the chain of nodes, frees its element and returns the node to the pool.
+ * `previous` must be the node before `current` (NULL if `current` is the head).
+ */
+static void unlinkNode(LinkedList list, node current, node previous) {
+    // If the node to be deleted is the head
+    if (previous == NULL) {
+        list->head = current->next; // Update the head to the next node
+    } else {
+        previous->next = current->next; // Bypass the current node
+    }
+
+    // If the node to be deleted is the tail
+    if (current == list->tail) {
+        list->tail = previous; // Update the tail to the previous node
+    } else if (hasBackLinks(list)) {
+        ((struct Double_Node*)current->next)->prev = previous; // Point the following node back past the deleted one
+    }
+
+    // Free the memory of the element and return the node to the pool (an intrusive node goes away with its element)
+    list->free_Func(current->element);
+    if (list->layout != LIST_LAYOUT_INTRUSIVE) {
+        releaseToPool(list->nodes, current);
+    }
+
+    // Decrease the size of the list
+    list->size--;
+}
+
+
+status appendNode(LinkedList list, Element element) {
+    // Check if the list or its required functions are NULL
+    if (list == NULL || list->free_Func == NULL || list->compare_func == NULL) {
+        return failure; // Return failure if the list or functions are not properly initialized
+    }
+
+    // Create the node pool on the first append
+    if (prepareNodePool(list) == failure) {
+        return failure;
+    }
+
+    if (list->layout == LIST_LAYOUT_UNROLLED) {
+        return appendToBlocks(list, element); // Unrolled lists pack the element into the last block
+    }
+
+    // Link a new node holding the element after the tail
+    return linkNewNode(list, element) != NULL ? success : failure;
+}
+
+
+status appendNodeWithHandle(LinkedList list, Element element, node* handle) {
+    // Check the inputs; handles are only handed out by doubly linked lists
+    if (list == NULL || handle == NULL || list->free_Func == NULL || list->compare_func == NULL ||
+        !hasBackLinks(list)) {
+        return failure;
+    }
+
+    // Create the node pool on the first append
+    if (prepareNodePool(list) == failure) {
+        return failure;
+    }
+
+    // Link a new node holding the element after the tail and give it to the caller as the handle
+    node new_node = linkNewNode(list, element);
+    if (new_node == NULL) {
+        return failure; // Return failure if the node could not be created
+    }
+
+    *handle = new_node;
+    return success;
+}
+
+
+status appendMany(LinkedList list, Element* elements, int count) {
+    // Check the inputs once for the whole batch
+    if (list == NULL || count < 0 || (elements == NULL && count > 0) || list->free_Func == NULL ||
+        list->compare_func == NULL) {
+        return failure;
+    }
+    if (count == 0) {
+        return success; // Nothing to append
+    }
+
+    // Create the node pool on the first append
+    if (prepareNodePool(list) == failure) {
+        return failure;
+    }
+
+    // Reserve every node the batch needs, so the loops below cannot fail halfway through
+    int needed = count;
+    if (list->layout == LIST_LAYOUT_UNROLLED) {
+        int room = list->lastBlock != NULL ? UNROLLED_NODE_CAPACITY - list->lastBlock->count : 0;
+        needed = count > room ? (count - room + UNROLLED_NODE_CAPACITY - 1) / UNROLLED_NODE_CAPACITY : 0;
+    }
+    if (list->layout != LIST_LAYOUT_INTRUSIVE && reserveInPool(list->nodes, (size_t)needed) == failure) {
+        return failure; // Nothing was appended
+    }
+
+    if (list->layout != LIST_LAYOUT_UNROLLED) {
+        // Link one node per element after the tail
+        for (int i = 0; i < count; i++) {
+            linkNewNode(list, elements[i]);
+        }
+        return success;
+    }
+
+    int done = 0; // Number of elements appended so far
+    while (done < count) {
+        block last = list->lastBlock;
+        if (last == NULL || last->count == UNROLLED_NODE_CAPACITY) {
+            appendToBlocks(list, elements[done++]); // Start a new block with the next element
+            continue;
+        }
+
+        // Fill the rest of the last block with a single copy
+        int chunk = UNROLLED_NODE_CAPACITY - last->count;
+        if (chunk > count - done) {
+            chunk = count - done;
+        }
+        memcpy(&last->elements[last->count], &elements[done], (size_t)chunk * sizeof(Element));
+        last->count += chunk;
+        list->size += chunk;
+        done += chunk;
+    }
+
+    return success;
 }
 
 
@@ -102,38 +518,27 @@ status deleteNode(LinkedList list, Element element) {
         return failure; // Return failure if the list is not properly initialized or empty
     }
 
+    if (list->layout == LIST_LAYOUT_UNROLLED) {
+        return deleteFromBlocks(list, element); // Unrolled lists remove the element from inside its block
+    }
+
     node current = list->head; // Start with the head of the list
     node previous = NULL;      // Pointer to keep track of the previous node (initialized to NULL)
+    int position = 0;          // Zero-based position of current, used to keep the indexed-access state valid
 
     // Traverse the linked list
     while (current != NULL) {
         // Check if the current node contains the target element
         if (list->compare_func(element, current->element)) {
-            // If the node to be deleted is the head
-            if (previous == NULL) {
-                list->head = current->next; // Update the head to the next node
-            } else {
-                previous->next = current->next; // Bypass the current node
-            }
-
-            // If the node to be deleted is the tail
-            if (current == list->tail) {
-                list->tail = previous; // Update the tail to the previous node
-            }
-
-            // Free the memory of the element and the node itself
-            list->free_Func(current->element);
-            free(current);
-
-            // Decrease the size of the list
-            list->size--;
-
+            forgetPositionsFrom(list, position); // Nodes after this position move one step forward
+            unlinkNode(list, current, previous); // Remove the node and free its element
             return success; // Return success after deleting the node
         }
 
         // Move to the next node
         previous = current;
         current = current->next;
+        position++;
     }
 
     // If the element was not found, return failure
@@ -141,6 +546,35 @@ status deleteNode(LinkedList list, Element element) {
 }
 
 
+status deleteNodeByHandle(LinkedList list, node handle) {
+    // Check the inputs; only doubly linked lists know the node before the handle
+    if (list == NULL || handle == NULL || list->free_Func == NULL || list->size == 0 ||
+        !hasBackLinks(list)) {
+        return failure;
+    }
+
+    // The handle's position is not known, so the finger and the skip index are dropped in O(1);
+    // getDataByIndex rebuilds the index on demand, only as far as the positions it is asked for
+    list->finger = NULL;
+    list->fingerPosition = -1;
+    list->skipValid = 0;
+    node previous = ((struct Double_Node*)handle)->prev;
+
+    // The handle's back pointer gives the previous node directly, so no search is needed
+    unlinkNode(list, handle, previous);
+    return success;
+}
+
+
+node getElementNode(LinkedList list, Element element) {
+    // Only intrusive lists know where an element's node is without searching
+    if (list == NULL || element == NULL || list->layout != LIST_LAYOUT_INTRUSIVE) {
+        return NULL;
+    }
+    return (node)((char*)element + list->linkOffset);
+}
+
+
 status displayList(LinkedList list) {
     // Check if the list or the print function is NULL
     if (list == NULL || list->print_func == NULL) {
@@ -155,23 +589,276 @@ status displayList(LinkedList list) {
         current = current->next; // Move to the next node in the list
     }
 
+    // In the unrolled layout, print the elements of each block in order
+    for (block b = list->firstBlock; b != NULL; b = b->next) {
+        for (int i = 0; i < b->count; i++) {
+            list->print_func(b->elements[i]);
+        }
+    }
+
     return success; // Return success after printing all elements
 }
 
+/*
+ * blockAtPosition:
+ * Finds the block of an unrolled list holding zero-based `position`.
+ * Starts from the finger block when it is at or before the position, otherwise from the first block,
+ * and leaves the finger on the block that was found.
+ */
+static block blockAtPosition(LinkedList list, int position) {
+    block b = list->firstBlock;
+    int start = 0; // Zero-based position of the first element of b
+
+    // Resume from the finger if it does not lie past the wanted position
+    if (list->fingerBlock != NULL && list->fingerPosition <= position) {
+        b = list->fingerBlock;
+        start = list->fingerPosition;
+    }
+
+    // Skip whole blocks until the one holding the position
+    while (position >= start + b->count) {
+        start += b->count;
+        b = b->next;
+    }
+
+    list->fingerBlock = b;
+    list->fingerPosition = start;
+    return b;
+}
+
+
+/*
+ * skipIndexEntry:
+ * Returns the skip index entry for position k * SKIP_INDEX_STRIDE, extending the valid part of the index
+ * from its last valid entry (or from the head) when needed. Returns NULL if the index cannot grow.
+ */
+static node skipIndexEntry(LinkedList list, int k) {
+    // Grow the array to hold an entry for every stride of the list
+    if (k >= list->skipCapacity) {
+        int capacity = list->size / SKIP_INDEX_STRIDE + 1;
+        node* grown = (node*)realloc(list->skipIndex, (size_t)capacity * sizeof(node));
+        if (grown == NULL) { // Check if memory allocation failed
+            return NULL;
+        }
+        list->skipIndex = grown;
+        list->skipCapacity = capacity;
+    }
+
+    // Rebuild the missing entries by walking forward from the last entry that is still correct
+    if (list->skipValid == 0) {
+        list->skipIndex[0] = list->head;
+        list->skipValid = 1;
+    }
+    while (list->skipValid <= k) {
+        node current = list->skipIndex[list->skipValid - 1];
+        for (int i = 0; i < SKIP_INDEX_STRIDE; i++) {
+            current = current->next;
+        }
+        list->skipIndex[list->skipValid++] = current;
+    }
+
+    return list->skipIndex[k];
+}
+
+
+/*
+ * nodeAtPosition:
+ * Finds the node at zero-based `position` of a single or double list and leaves the finger on it.
+ * Nearby positions are reached by stepping from the finger (backwards too in the double layout);
+ * anything else starts from the closest skip index entry, so no call walks more than a stride.
+ */
+static node nodeAtPosition(LinkedList list, int position) {
+    int distance = position - list->fingerPosition;
+    node current = NULL;
+
+    if (list->finger != NULL && distance >= 0 && distance < SKIP_INDEX_STRIDE) {
+        // Close after the finger: step forward from it
+        current = list->finger;
+        for (int i = 0; i < distance; i++) {
+            current = current->next;
+        }
+    } else if (list->finger != NULL && hasBackLinks(list) &&
+               distance < 0 && distance > -SKIP_INDEX_STRIDE) {
+        // Close before the finger in a doubly linked list: step back from it
+        current = list->finger;
+        for (int i = 0; i > distance; i--) {
+            current = ((struct Double_Node*)current)->prev;
+        }
+    } else {
+        // Jump to the closest skip index entry before the position, then step forward
+        current = skipIndexEntry(list, position / SKIP_INDEX_STRIDE);
+        if (current == NULL) {
+            // Without an index (memory allocation failed) fall back to walking from the head
+            current = list->head;
+            for (int i = 0; i < position; i++) {
+                current = current->next;
+            }
+        } else {
+            for (int i = 0; i < position % SKIP_INDEX_STRIDE; i++) {
+                current = current->next;
+            }
+        }
+    }
+
+    list->finger = current;
+    list->fingerPosition = position;
+    return current;
+}
+
+
 Element getDataByIndex(LinkedList list, int index) {
-    // Validate the list and the index
-    if (list == NULL || index < 1 || index >= list->size) {
+    // Validate the list and the index (indices start at 1)
+    if (list == NULL || index < 1 || index > list->size) {
         return NULL; // Return NULL if the list is not initialized or the index is out of bounds
     }
 
-    node current = list->head; // Start at the head of the list
+    int position = index - 1; // Zero-based position of the element
 
-    // Traverse the list to the specified index
-    for (int i = 1; i < index; i++) {
-        current = current->next; // Move to the next node
+    if (list->layout == LIST_LAYOUT_UNROLLED) {
+        // Find the block holding the position, then read the element straight out of it
+        block b = blockAtPosition(list, position);
+        return b->elements[position - list->fingerPosition];
     }
 
-    return current->element; // Return the element at the specified index
+    return nodeAtPosition(list, position)->element; // Return the element at the specified index
+}
+
+
+status spliceLists(LinkedList dst, LinkedList src) {
+    // Check the inputs; nodes of different layouts cannot be chained together
+    if (dst == NULL || src == NULL || dst == src || dst->layout != src->layout || dst->linkOffset != src->linkOffset) {
+        return failure;
+    }
+    if (src->size == 0) {
+        return success; // Nothing to move
+    }
+
+    // The nodes stay where they are, so dst must be able to release them to their pool later
+    if (dst->nodes == NULL) {
+        dst->nodes = shareMemoryPool(src->nodes);
+    } else if (mergeMemoryPools(dst->nodes, src->nodes) == failure) {
+        return failure;
+    }
+
+    if (dst->layout == LIST_LAYOUT_UNROLLED) {
+        // Chain src's blocks after dst's last block
+        if (dst->lastBlock == NULL) {
+            dst->firstBlock = src->firstBlock;
+        } else {
+            dst->lastBlock->next = src->firstBlock;
+        }
+        dst->lastBlock = src->lastBlock;
+        src->firstBlock = NULL;
+        src->lastBlock = NULL;
+    } else {
+        // Chain src's nodes after dst's tail
+        if (dst->tail == NULL) {
+            dst->head = src->head;
+        } else {
+            dst->tail->next = src->head;
+        }
+        if (hasBackLinks(dst)) {
+            ((struct Double_Node*)src->head)->prev = dst->tail;
+        }
+        dst->tail = src->tail;
+        src->head = NULL;
+        src->tail = NULL;
+    }
+
+    // dst's positions do not change, so its finger and skip index stay valid; src has no positions left
+    dst->size += src->size;
+    src->size = 0;
+    src->finger = NULL;
+    src->fingerBlock = NULL;
+    src->fingerPosition = -1;
+    src->skipValid = 0;
+
+    return success;
+}
+
+
+LinkedList splitAt(LinkedList list, int index) {
+    // Validate the list and the split point
+    if (list == NULL || index < 0 || index > list->size) {
+        return NULL;
+    }
+
+    // The rest of the list goes to a new list with the same layout and functions
+    LinkedList rest = list->layout == LIST_LAYOUT_INTRUSIVE
+                          ? createIntrusiveLinkedList(list->free_Func, list->compare_func, list->print_func,
+                                                      list->linkOffset)
+                          : createLinkedListWithLayout(list->free_Func, list->compare_func, list->print_func,
+                                                       list->layout);
+    if (rest == NULL || index == list->size) {
+        return rest; // Nothing to move (or memory allocation failed)
+    }
+
+    if (list->layout == LIST_LAYOUT_UNROLLED) {
+        block first = list->firstBlock; // First block of the rest
+        block last = NULL;              // Last block kept by the list
+        if (index > 0) {
+            last = blockAtPosition(list, index - 1);
+            first = last->next;
+            int keep = index - list->fingerPosition; // Elements of `last` that stay in the list
+
+            // Elements of the same block past the split point move to a block of their own
+            if (keep < last->count) {
+                block moved = (block)allocateFromPool(list->nodes);
+                if (moved == NULL) { // Check if memory allocation failed
+                    destroyLinkedList(rest);
+                    return NULL;
+                }
+                moved->count = last->count - keep;
+                memcpy(moved->elements, &last->elements[keep], (size_t)moved->count * sizeof(Element));
+                moved->next = last->next;
+                last->count = keep;
+                if (last == list->lastBlock) {
+                    list->lastBlock = moved;
+                }
+                first = moved;
+            }
+            last->next = NULL;
+        }
+
+        rest->firstBlock = first;
+        rest->lastBlock = list->lastBlock;
+        list->lastBlock = last;
+        if (last == NULL) {
+            list->firstBlock = NULL;
+        }
+    } else {
+        node last = index > 0 ? nodeAtPosition(list, index - 1) : NULL; // Last node kept by the list
+
+        rest->head = last != NULL ? last->next : list->head;
+        rest->tail = list->tail;
+        if (hasBackLinks(list)) {
+            ((struct Double_Node*)rest->head)->prev = NULL;
+        }
+        list->tail = last;
+        if (last == NULL) {
+            list->head = NULL;
+        } else {
+            last->next = NULL;
+        }
+    }
+
+    // Both lists now hold nodes from the same pool
+    rest->nodes = shareMemoryPool(list->nodes);
+    rest->size = list->size - index;
+    list->size = index;
+
+    // Positions before the split point are unchanged; forget anything at or after it
+    int stillValid = (index + SKIP_INDEX_STRIDE - 1) / SKIP_INDEX_STRIDE;
+    if (list->skipValid > stillValid) {
+        list->skipValid = stillValid;
+    }
+    if (list->fingerPosition >= index) {
+        list->finger = NULL;
+        list->fingerBlock = NULL;
+        list->fingerPosition = -1;
+    }
+
+    return rest;
 }
 
 
@@ -201,16 +888,29 @@ Element searchByKeyInList(LinkedList list, Element dataKey, bool (*has_data)(Ele
         current = current->next; // Move to the next node
     }
 
+    // In the unrolled layout, scan the elements of each block in order
+    for (block b = list->firstBlock; b != NULL; b = b->next) {
+        for (int i = 0; i < b->count; i++) {
+            if (has_data(b->elements[i], dataKey)) {
+                return b->elements[i]; // Return the element if a match is found
+            }
+        }
+    }
+
     return NULL; // Return NULL if no matching element is found
 }
 
 
 Element getFirstElement(LinkedList list) {
-    // Check if the list or the head of the list is NULL
-    if (!list || !list->head) {
+    // Check if the list is NULL or empty
+    if (!list || list->size == 0) {
         return NULL; // Return NULL if the list is not initialized or empty
     }
 
+    if (list->layout == LIST_LAYOUT_UNROLLED) {
+        return list->firstBlock->elements[0]; // The first element sits at the front of the first block
+    }
+
     return list->head->element; // Return the element stored in the head node
 }
 
@@ -232,6 +932,18 @@ Element getNextElement(LinkedList list, Element currentElement) {
         temp = temp->next; // Move to the next node
     }
 
+    // In the unrolled layout, find the element inside its block and return its successor
+    for (block b = list->firstBlock; b != NULL; b = b->next) {
+        for (int i = 0; i < b->count; i++) {
+            if (b->elements[i] == currentElement) {
+                if (i + 1 < b->count) {
+                    return b->elements[i + 1]; // The successor is in the same block
+                }
+                return b->next ? b->next->elements[0] : NULL; // Otherwise it starts the next block
+            }
+        }
+    }
+
     return NULL; // Return NULL if the current element is not found in the list
 }
 
@@ -244,3 +956,251 @@ Element get_data(node node) {
 
     return node->element; // Return the element stored in the node
 }
+
+
+ListIterator listBegin(LinkedList list) {
+    ListIterator iterator;
+    iterator.list = list;                          // Remember which list is being traversed
+    iterator.current = list ? list->head : NULL;   // Start at the head (NULL for a missing or empty list)
+    iterator.block = list ? list->firstBlock : NULL; // Start at the first block (unrolled layout)
+    iterator.offset = 0;
+    return iterator;
+}
+
+
+bool listIteratorValid(const ListIterator* iterator) {
+    // The iterator is valid as long as it stands on a node or a block
+    return (iterator != NULL && (iterator->current != NULL || iterator->block != NULL)) ? true : false;
+}
+
+
+void listIteratorNext(ListIterator* iterator) {
+    // Check if the iterator is NULL
+    if (!iterator) {
+        return; // Nothing to advance
+    }
+
+    // In the unrolled layout, move inside the block and step to the next block at its end
+    if (iterator->block != NULL) {
+        iterator->offset++;
+        if (iterator->offset >= iterator->block->count) {
+            iterator->block = iterator->block->next;
+            iterator->offset = 0;
+        }
+        return;
+    }
+
+    // Check if the iterator is already past the end
+    if (!iterator->current) {
+        return; // Nothing to advance
+    }
+
+    iterator->current = iterator->current->next; // Step to the following node without searching
+}
+
+
+Element listIteratorData(const ListIterator* iterator) {
+    // Check if the iterator is NULL
+    if (!iterator) {
+        return NULL;
+    }
+
+    // In the unrolled layout the element is read straight out of the block
+    if (iterator->block != NULL) {
+        return iterator->block->elements[iterator->offset];
+    }
+
+    // Check if the iterator is past the end
+    if (!iterator->current) {
+        return NULL; // Return NULL if there is no current node
+    }
+
+    return iterator->current->element; // Return the element stored in the current node
+}
+
+
+status forEachInList(LinkedList list, VisitFunction visit, Element context) {
+    // Check if the list or the visitor function is NULL
+    if (list == NULL || visit == NULL) {
+        return failure; // Return failure if the list or visitor is not initialized
+    }
+
+    node current = list->head; // Start with the head of the list
+
+    // Traverse the linked list once, handing each element to the visitor
+    while (current != NULL) {
+        node next = current->next; // Save the next node in case the visitor removes the current one
+        if (visit(current->element, context) == failure) {
+            return failure; // Stop as soon as the visitor reports failure
+        }
+        current = next; // Move to the next node
+    }
+
+    // In the unrolled layout, visit the elements of each block in order
+    for (block b = list->firstBlock; b != NULL; b = b->next) {
+        for (int i = 0; i < b->count; i++) {
+            if (visit(b->elements[i], context) == failure) {
+                return failure; // Stop as soon as the visitor reports failure
+            }
+        }
+    }
+
+    return success; // Return success after visiting all elements
+}
+
+
+// One range of consecutive elements, handled by a single task of a parallel pass
+typedef struct List_Range {
+    ListIterator begin;    // Iterator on the first element of the range
+    int count;             // Number of elements in the range
+    status result;         // failure once a callback of this range reported failure
+} ListRange;
+
+// Everything the tasks of a parallel pass share
+typedef struct Parallel_Pass {
+    ListRange* ranges;              // One range per task
+    VisitFunction visit;            // Visitor called for every element (parallelForEach), or NULL
+    AccumulateFunction accumulate;  // Accumulator called for every element (parallelReduce), or NULL
+    Element context;                // Context handed to every callback
+    Element* partials;              // Partial result of each range (parallelReduce only)
+} ParallelPass;
+
+
+/*
+ * prepareRanges:
+ * Cuts a non-empty list into `count` ranges of about the same length and positions an iterator on each start.
+ * Single and double lists start their ranges on skip index entries, so later passes find them without a walk;
+ * unrolled lists skip whole blocks. Returns NULL if memory allocation failed.
+ */
+static ListRange* prepareRanges(LinkedList list, int count) {
+    ListRange* ranges = (ListRange*)malloc((size_t)count * sizeof(ListRange));
+    if (ranges == NULL) { // Check if memory allocation failed
+        return NULL;
+    }
+
+    block b = list->firstBlock; // Block holding the current range start (unrolled layout)
+    int blockStart = 0;         // Zero-based position of the first element of b
+    int previousStart = 0;      // Start of the previous range
+
+    for (int i = 0; i < count; i++) {
+        int start = (int)((long long)list->size * i / count);
+        ranges[i].begin = listBegin(list);
+        ranges[i].result = success;
+
+        if (list->layout == LIST_LAYOUT_UNROLLED) {
+            // Skip the blocks that end before the range starts
+            while (start >= blockStart + b->count) {
+                blockStart += b->count;
+                b = b->next;
+            }
+            ranges[i].begin.block = b;
+            ranges[i].begin.offset = start - blockStart;
+        } else {
+            // Round the start down to the closest skip index entry
+            start -= start % SKIP_INDEX_STRIDE;
+            ranges[i].begin.current = skipIndexEntry(list, start / SKIP_INDEX_STRIDE);
+            if (ranges[i].begin.current == NULL) { // The skip index could not grow
+                free(ranges);
+                return NULL;
+            }
+        }
+
+        // Each range ends where the next one begins; the last one ends with the list
+        if (i > 0) {
+            ranges[i - 1].count = start - previousStart;
+        }
+        previousStart = start;
+    }
+    ranges[count - 1].count = list->size - previousStart;
+
+    return ranges;
+}
+
+
+/*
+ * passOverRange:
+ * Task of a parallel pass: hands every element of one range to the visitor or the accumulator.
+ */
+static void passOverRange(Element argument, int taskIndex) {
+    ParallelPass* pass = (ParallelPass*)argument;
+    ListRange* range = &pass->ranges[taskIndex];
+    ListIterator iterator = range->begin;
+
+    for (int i = 0; i < range->count; i++) {
+        Element element = listIteratorData(&iterator);
+        status result = pass->visit != NULL ? pass->visit(element, pass->context)
+                                            : pass->accumulate(pass->partials[taskIndex], element, pass->context);
+        if (result == failure) {
+            range->result = failure; // Stop this range; the others finish on their own
+            return;
+        }
+        listIteratorNext(&iterator);
+    }
+}
+
+
+/*
+ * runParallelPass:
+ * Runs one task per range on the worker pool, frees the ranges and reports whether every range succeeded.
+ */
+static status runParallelPass(ParallelPass* pass, int count, int nthreads) {
+    status result = runInParallel(passOverRange, pass, count, nthreads);
+    for (int i = 0; i < count; i++) {
+        if (pass->ranges[i].result == failure) {
+            result = failure;
+        }
+    }
+    free(pass->ranges);
+    return result;
+}
+
+
+status parallelForEach(LinkedList list, VisitFunction visit, Element context, int nthreads) {
+    // Check the inputs
+    if (list == NULL || visit == NULL || nthreads < 1) {
+        return failure;
+    }
+
+    // Short lists, a single thread, or no memory for the ranges: visit in order on this thread
+    ListRange* ranges = NULL;
+    if (nthreads == 1 || list->size < PARALLEL_MIN_ELEMENTS || (ranges = prepareRanges(list, nthreads)) == NULL) {
+        return forEachInList(list, visit, context);
+    }
+
+    ParallelPass pass = {ranges, visit, NULL, context, NULL};
+    return runParallelPass(&pass, nthreads, nthreads);
+}
+
+
+status parallelReduce(LinkedList list, AccumulateFunction accumulate, CombineFunction combine, Element context,
+                      Element* partials, int nthreads) {
+    // Check the inputs
+    if (list == NULL || accumulate == NULL || combine == NULL || partials == NULL || nthreads < 1) {
+        return failure;
+    }
+
+    // Short lists, a single thread, or no memory for the ranges: fold everything into partials[0] in order
+    ListRange* ranges = NULL;
+    if (nthreads == 1 || list->size < PARALLEL_MIN_ELEMENTS || (ranges = prepareRanges(list, nthreads)) == NULL) {
+        for (ListIterator it = listBegin(list); listIteratorValid(&it); listIteratorNext(&it)) {
+            if (accumulate(partials[0], listIteratorData(&it), context) == failure) {
+                return failure;
+            }
+        }
+        return success;
+    }
+
+    // Fold every range into its own partial result in parallel
+    ParallelPass pass = {ranges, NULL, accumulate, context, partials};
+    if (runParallelPass(&pass, nthreads, nthreads) == failure) {
+        return failure;
+    }
+
+    // Combine the partial results in range order, so the result does not depend on which thread finished first
+    for (int i = 1; i < nthreads; i++) {
+        if (combine(partials[0], partials[i], context) == failure) {
+            return failure;
+        }
+    }
+    return success;
+}
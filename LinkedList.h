@@ -5,6 +5,7 @@
 #ifndef LINKEDLIST_H
 #define LINKEDLIST_H
 #include "Defs.h"
+#include "MemoryPool.h"
 
 
 
@@ -13,12 +14,81 @@
 typedef struct Linked_List *LinkedList; // Defines LinkedList as a pointer to a Linked_List structure
 typedef struct Node* node;             // Defines node as a pointer to a Node structure
 
+// Number of elements held by one node of an unrolled list (14 pointers fill a 128-byte node)
+#define UNROLLED_NODE_CAPACITY 14
+
+// Lists shorter than this are not worth handing to worker threads in parallelForEach and parallelReduce
+#define PARALLEL_MIN_ELEMENTS 4096
+
+// Storage layouts a linked list can be created with
+typedef enum e_listLayout {
+    LIST_LAYOUT_SINGLE,   // One element per node (the layout createLinkedList uses)
+    LIST_LAYOUT_DOUBLE,   // One element per node with a back pointer, so nodes can be removed by handle in O(1)
+    LIST_LAYOUT_UNROLLED, // Up to UNROLLED_NODE_CAPACITY elements stored contiguously in each node
+    LIST_LAYOUT_INTRUSIVE // Like LIST_LAYOUT_DOUBLE, but the links live inside the elements (createIntrusiveLinkedList)
+} ListLayout;
+
+// Links of an element in an intrusive list; embed one in the element's struct for every such list it can be in
+// The list manages the contents; the element must not be moved or freed while it is linked
+typedef struct List_Link {
+    Element storage[3]; // The element, the next link and the previous link
+} ListLink;
+
+// Cursor over the nodes of a linked list.
+// The iterator remembers the node it stands on, so advancing it is O(1)
+// (unlike getNextElement, which searches for the current element from the head).
+typedef struct List_Iterator {
+    LinkedList list;   // The list being traversed
+    node current;      // The node the iterator stands on (NULL once past the end)
+    struct Unrolled_Node* block; // The block the iterator stands on (unrolled layout only)
+    int offset;        // Position of the current element inside block (unrolled layout only)
+} ListIterator;
+
 // Function to create a linked list
 // free_func: A function to free memory for elements in the list
 // compare_func: A function to compare two elements
 // print_func: A function to print an element
 LinkedList createLinkedList(FreeFunction free_func, EqualFunction compare_func, PrintFunction print_func);
 
+// Function to create a linked list with a chosen storage layout
+// All other list functions keep the same behavior for every layout
+// free_func: A function to free memory for elements in the list
+// compare_func: A function to compare two elements
+// print_func: A function to print an element
+// layout: LIST_LAYOUT_SINGLE, LIST_LAYOUT_DOUBLE for lists that delete by handle,
+//         or LIST_LAYOUT_UNROLLED for long lists that are mostly scanned
+//         (LIST_LAYOUT_INTRUSIVE lists are created with createIntrusiveLinkedList)
+LinkedList createLinkedListWithLayout(FreeFunction free_func, EqualFunction compare_func, PrintFunction print_func,
+                                      ListLayout layout);
+
+// Function to create a node pool that several lists of one layout can share (see createLinkedListInPool)
+// Many short lists, such as the value lists of a multi-value hash table, then fill the same slabs
+// instead of each paying for a pool header and a mostly empty first slab of its own
+// layout: The layout of the lists that will share the pool (not LIST_LAYOUT_INTRUSIVE, which has no nodes to pool)
+// Returns: The new pool, or NULL on failure; the creator releases it with destroyMemoryPool when done
+MemoryPool createListNodePool(ListLayout layout);
+
+// Function to create a linked list whose nodes come from a shared pool
+// The list becomes one more user of the pool and gives its nodes back to it when destroyed,
+// so the other lists of the pool reuse them
+// free_func: A function to free memory for elements in the list
+// compare_func: A function to compare two elements
+// print_func: A function to print an element
+// layout: LIST_LAYOUT_SINGLE, LIST_LAYOUT_DOUBLE or LIST_LAYOUT_UNROLLED
+// pool: A pool created by createListNodePool for the same layout
+LinkedList createLinkedListInPool(FreeFunction free_func, EqualFunction compare_func, PrintFunction print_func,
+                                  ListLayout layout, MemoryPool pool);
+
+// Function to create an intrusive linked list, whose elements carry their own links
+// Appending allocates nothing and traversal reads the links straight from the elements;
+// an element can be in only one list per embedded ListLink at a time
+// free_func: A function to free memory for elements in the list
+// compare_func: A function to compare two elements
+// print_func: A function to print an element
+// linkOffset: Offset of the ListLink inside every element, e.g. offsetof(Jerry, daycare_link)
+LinkedList createIntrusiveLinkedList(FreeFunction free_func, EqualFunction compare_func, PrintFunction print_func,
+                                     size_t linkOffset);
+
 // Function to destroy a linked list and free all associated memory
 // list: A pointer to the linked list
 status destroyLinkedList(LinkedList list);
@@ -28,18 +98,63 @@ status destroyLinkedList(LinkedList list);
 // Element: The element to be added
 status appendNode(LinkedList list, Element);
 
+// Function to append a new node to the end of a doubly linked list and return a handle to it
+// Only lists created with LIST_LAYOUT_DOUBLE or LIST_LAYOUT_INTRUSIVE hand out handles
+// list: A pointer to the linked list
+// element: The element to be added
+// handle: Receives the new node; it stays valid until that node is deleted
+status appendNodeWithHandle(LinkedList list, Element element, node* handle);
+
+// Function to append several elements to the end of the linked list at once
+// All nodes are reserved up front, so either every element is appended or (on allocation failure) none is
+// list: A pointer to the linked list
+// elements: The elements to be added, in order
+// count: The number of elements
+status appendMany(LinkedList list, Element* elements, int count);
+
+// Function to move every element of `src` to the end of `dst` in O(1), leaving `src` empty
+// Both lists must use the same layout; the moved elements are freed with dst's free function from now on,
+// and handles obtained from src now belong to dst
+// dst: The list that receives the elements
+// src: The list the elements are taken from
+status spliceLists(LinkedList dst, LinkedList src);
+
+// Function to split the linked list in two: the list keeps its first `index` elements
+// and the rest are moved, in order, to a new list with the same layout and functions
+// Only the split point is looked up (like getDataByIndex); the moved nodes are not copied
+// list: A pointer to the linked list
+// index: The number of elements to keep, from 0 to getLength(list)
+// Returns: The new list holding the remaining elements, or NULL on failure
+LinkedList splitAt(LinkedList list, int index);
+
 // Function to delete a node from the linked list
 // list: A pointer to the linked list
 // Element: The element to be deleted
 status deleteNode(LinkedList list, Element);
 
+// Function to delete a node of a doubly linked list in O(1), without searching or calling compare_func
+// The element is freed with the list's free function, like deleteNode does
+// list: A pointer to the linked list the handle was obtained from
+// handle: A handle returned by appendNodeWithHandle (or getElementNode) for this list
+status deleteNodeByHandle(LinkedList list, node handle);
+
+// Function to get the node of an element in an intrusive list in O(1), for use with deleteNodeByHandle
+// list: A pointer to an intrusive linked list
+// element: An element currently in the list
+// Returns: The element's node, or NULL if the list is not intrusive
+node getElementNode(LinkedList list, Element element);
+
 // Function to display all elements in the linked list
 // list: A pointer to the linked list
 status displayList(LinkedList list);
 
 // Function to get the element at a specific index in the linked list
+// The list remembers the last position it returned, so sequential or nearby indices cost O(1);
+// other indices start from a skip index holding every 64th node (unrolled lists skip whole blocks instead).
+// deleteNode moves the later entries on by one node; deleteNodeByHandle drops the index, which is then rebuilt
+// lazily, only up to the indices asked for
 // list: A pointer to the linked list
-// index: The index of the desired element
+// index: The index of the desired element, from 1 (first element) to getLength(list)
 Element getDataByIndex(LinkedList list, int index);
 
 // Function to get the number of nodes in the linked list
@@ -57,10 +172,64 @@ Element searchByKeyInList(LinkedList list, Element element, bool (*has_data)(Ele
 Element getFirstElement(LinkedList list);
 
 // Function to get the next element in the linked list after a given element
+// Searches for currentElement from the head, so every call is O(n);
+// use a ListIterator or forEachInList for full traversals
 // list: A pointer to the linked list
 // currentElement: The current element
 Element getNextElement(LinkedList list, Element currentElement);
 
+// Function to get an iterator positioned on the first node of the linked list
+// list: A pointer to the linked list
+// Returns: An iterator that is already invalid if the list is NULL or empty
+ListIterator listBegin(LinkedList list);
+
+// Function to check whether an iterator still points at a node
+// iterator: A pointer to the iterator
+// Returns: true while the iterator stands on a node, false once it has passed the end
+bool listIteratorValid(const ListIterator* iterator);
+
+// Function to advance an iterator to the following node in O(1)
+// iterator: A pointer to the iterator
+void listIteratorNext(ListIterator* iterator);
+
+// Function to get the element the iterator currently points at
+// iterator: A pointer to the iterator
+// Returns: The current element, or NULL if the iterator is invalid
+Element listIteratorData(const ListIterator* iterator);
+
+// Function to call a visitor for every element of the linked list in order
+// list: A pointer to the linked list
+// visit: The function called for each element
+// context: An arbitrary pointer handed to every call of visit
+// Returns: failure if the list or visitor is NULL or if visit returned failure (the traversal stops there)
+status forEachInList(LinkedList list, VisitFunction visit, Element context);
+
+// Function to call a visitor for every element of the linked list, spread over several threads
+// The list is cut into nthreads ranges of consecutive elements that run on the shared worker pool;
+// lists shorter than PARALLEL_MIN_ELEMENTS are visited in order on the calling thread
+// visit must be safe to call on different elements at the same time and must not change the list
+// list: A pointer to the linked list
+// visit: The function called for each element
+// context: An arbitrary pointer handed to every call of visit
+// nthreads: The maximum number of threads to use
+// Returns: failure if an argument is invalid or visit returned failure (its range stops there)
+status parallelForEach(LinkedList list, VisitFunction visit, Element context, int nthreads);
+
+// Function to reduce the linked list to a single result, spread over several threads
+// Range i of nthreads ranges of consecutive elements is folded into partials[i] with accumulate;
+// afterwards the later partials are combined into partials[0] in range order on the calling thread,
+// so the result depends only on the list and nthreads, never on thread timing
+// (short lists are folded into partials[0] in order)
+// list: A pointer to the linked list
+// accumulate: Folds one element into a partial result
+// combine: Merges a later partial result into an earlier one
+// context: An arbitrary pointer handed to every call of accumulate and combine
+// partials: nthreads partial results, each already set to the reduction's starting value
+// nthreads: The maximum number of threads to use
+// Returns: failure if an argument is invalid or accumulate or combine returned failure
+status parallelReduce(LinkedList list, AccumulateFunction accumulate, CombineFunction combine, Element context,
+                      Element* partials, int nthreads);
+
 // Function to get the data stored in a specific node
 // node: A pointer to a node in the linked list
 Element get_data(node node);
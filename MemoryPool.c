@@ -0,0 +1,294 @@
+//
+// Slab allocator for fixed-size objects such as linked list nodes.
+//
+#include <stdlib.h>
+#include "MemoryPool.h"
+
+#define POOL_FIRST_SLAB_OBJECTS 4           // Number of objects in the first (smallest) slab
+#define POOL_MAX_SLAB_BYTES (1024 * 1024)   // Slabs stop doubling once they reach this size
+
+// Header at the start of every slab; the objects follow it in the same allocation
+typedef struct Pool_Slab {
+    struct Pool_Slab* next;  // Next slab owned by the same pool
+} PoolSlab;
+
+// Released object; the link is stored inside the object's own memory
+typedef struct Free_Object {
+    struct Free_Object* next; // Next released object
+} FreeObject;
+
+// Definition of the Memory_Pool structure
+struct Memory_Pool {
+    size_t objectSize;     // Size of every object, rounded up to keep objects pointer-aligned
+    FreeObject* freeList;  // Objects that were released and can be handed out again
+    FreeObject* freeTail;  // Last object of freeList, so another free list can be appended in O(1)
+    size_t freeCount;      // Number of objects on freeList
+    PoolSlab* slabs;       // All slabs allocated by this pool (released together on destroy)
+    PoolSlab* oldestSlab;  // Last slab of the slabs chain, so another chain can be appended in O(1)
+    char* bump;            // Next never-used object in the newest slab
+    char* bumpEnd;         // End of the newest slab
+    size_t nextSlabObjects; // Number of objects the next slab will hold
+    int users;             // Number of handles (and merged pools) that still refer to this pool
+    struct Memory_Pool* mergedInto; // Pool that took over this pool's memory, or NULL
+};
+
+
+MemoryPool createMemoryPool(size_t objectSize) {
+    // Check that the object size is valid
+    if (objectSize == 0) {
+        return NULL; // Return NULL for a zero object size
+    }
+
+    // Allocate memory for a new Memory_Pool structure
+    MemoryPool pool = (MemoryPool)malloc(sizeof(struct Memory_Pool));
+    if (!pool) { // Check if memory allocation failed
+        return NULL;
+    }
+
+    // Round the object size up so every object is aligned like a pointer and can hold the free-list link
+    size_t align = sizeof(void*);
+    if (objectSize < sizeof(FreeObject)) {
+        objectSize = sizeof(FreeObject);
+    }
+    pool->objectSize = (objectSize + align - 1) / align * align;
+
+    // Initialize an empty pool; the first slab is allocated on the first request
+    pool->freeList = NULL;
+    pool->freeTail = NULL;
+    pool->freeCount = 0;
+    pool->slabs = NULL;
+    pool->oldestSlab = NULL;
+    pool->bump = NULL;
+    pool->bumpEnd = NULL;
+    pool->nextSlabObjects = POOL_FIRST_SLAB_OBJECTS;
+    pool->users = 1;          // The creator is the first user
+    pool->mergedInto = NULL;
+
+    return pool;
+}
+
+
+/*
+ * activePool:
+ * Follows the chain of merges from a handle to the pool that currently owns the memory.
+ */
+static MemoryPool activePool(MemoryPool pool) {
+    while (pool->mergedInto != NULL) {
+        pool = pool->mergedInto;
+    }
+    return pool;
+}
+
+
+status destroyMemoryPool(MemoryPool pool) {
+    // Check if the pool is NULL
+    if (pool == NULL) {
+        return failure;
+    }
+
+    // Other users still need the pool, so only drop this user
+    if (--pool->users > 0) {
+        return success;
+    }
+
+    // A merged pool owns no memory; drop its reference to the pool that took the memory over
+    if (pool->mergedInto != NULL) {
+        MemoryPool owner = pool->mergedInto;
+        free(pool);
+        return destroyMemoryPool(owner);
+    }
+
+    // Release every slab; the objects inside them go away together
+    PoolSlab* slab = pool->slabs;
+    while (slab != NULL) {
+        PoolSlab* next = slab->next; // Save the next slab before freeing this one
+        free(slab);
+        slab = next;
+    }
+
+    free(pool); // Free the pool structure itself
+    return success;
+}
+
+
+/*
+ * addSlab:
+ * Allocates a new slab for the pool and makes it the bump-allocation area.
+ * Each slab holds twice as many objects as the previous one until it reaches POOL_MAX_SLAB_BYTES.
+ */
+static status addSlab(MemoryPool pool) {
+    size_t objects = pool->nextSlabObjects;
+
+    // Allocate the slab header and its objects in a single block
+    PoolSlab* slab = (PoolSlab*)malloc(sizeof(PoolSlab) + objects * pool->objectSize);
+    if (!slab) { // Check if memory allocation failed
+        return failure;
+    }
+
+    // Objects left in the current slab would be lost when the bump area moves, so keep them on the free list
+    while (pool->bump != pool->bumpEnd) {
+        releaseToPool(pool, pool->bump);
+        pool->bump += pool->objectSize;
+    }
+
+    // Link the slab into the pool so destroyMemoryPool can find it
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    if (pool->oldestSlab == NULL) {
+        pool->oldestSlab = slab;
+    }
+
+    // The new objects are handed out in order starting right after the header
+    pool->bump = (char*)(slab + 1);
+    pool->bumpEnd = pool->bump + objects * pool->objectSize;
+
+    // Double the size of the next slab, up to the maximum slab size
+    if ((objects * 2) * pool->objectSize <= POOL_MAX_SLAB_BYTES) {
+        pool->nextSlabObjects = objects * 2;
+    }
+
+    return success;
+}
+
+
+void* allocateFromPool(MemoryPool pool) {
+    // Check if the pool is NULL
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool = activePool(pool); // Allocate from the pool that owns the memory
+
+    // Prefer an object that was released earlier
+    if (pool->freeList != NULL) {
+        FreeObject* object = pool->freeList;
+        pool->freeList = object->next; // Pop it from the free list
+        if (pool->freeList == NULL) {
+            pool->freeTail = NULL;
+        }
+        pool->freeCount--;
+        return object;
+    }
+
+    // Otherwise take the next untouched object, adding a slab if the current one is used up
+    if (pool->bump == pool->bumpEnd && addSlab(pool) == failure) {
+        return NULL; // Return NULL if a new slab could not be allocated
+    }
+
+    void* object = pool->bump;
+    pool->bump += pool->objectSize; // Advance past the object just handed out
+    return object;
+}
+
+
+status releaseToPool(MemoryPool pool, void* object) {
+    // Check if the pool or the object is NULL
+    if (pool == NULL || object == NULL) {
+        return failure;
+    }
+
+    pool = activePool(pool); // Release into the pool that owns the memory
+
+    // Push the object onto the free list, reusing its memory for the link
+    FreeObject* released = (FreeObject*)object;
+    released->next = pool->freeList;
+    pool->freeList = released;
+    if (pool->freeTail == NULL) {
+        pool->freeTail = released;
+    }
+    pool->freeCount++;
+
+    return success;
+}
+
+
+MemoryPool shareMemoryPool(MemoryPool pool) {
+    // Count the new user; the handle itself does not change
+    if (pool != NULL) {
+        pool->users++;
+    }
+    return pool;
+}
+
+
+status mergeMemoryPools(MemoryPool into, MemoryPool from) {
+    // Check the inputs
+    if (into == NULL || from == NULL) {
+        return failure;
+    }
+    into = activePool(into);
+    from = activePool(from);
+    if (into == from) {
+        return success; // The handles already share their memory
+    }
+    if (into->objectSize != from->objectSize) {
+        return failure; // Objects of different sizes cannot be mixed
+    }
+
+    // Append the other pool's slabs to this pool's chain
+    if (from->slabs != NULL) {
+        if (into->slabs == NULL) {
+            into->slabs = from->slabs;
+        } else {
+            into->oldestSlab->next = from->slabs;
+        }
+        into->oldestSlab = from->oldestSlab;
+    }
+
+    // Append the other pool's released objects to this pool's free list
+    if (from->freeList != NULL) {
+        if (into->freeList == NULL) {
+            into->freeList = from->freeList;
+        } else {
+            into->freeTail->next = from->freeList;
+        }
+        into->freeTail = from->freeTail;
+        into->freeCount += from->freeCount;
+    }
+
+    // Keep the larger unused area of the two newest slabs (the other one stays allocated until destroy)
+    if (from->bumpEnd - from->bump > into->bumpEnd - into->bump) {
+        into->bump = from->bump;
+        into->bumpEnd = from->bumpEnd;
+    }
+    if (from->nextSlabObjects > into->nextSlabObjects) {
+        into->nextSlabObjects = from->nextSlabObjects;
+    }
+
+    // The other pool now only forwards to this one, and keeps it alive while it has users
+    from->slabs = NULL;
+    from->oldestSlab = NULL;
+    from->freeList = NULL;
+    from->freeTail = NULL;
+    from->freeCount = 0;
+    from->bump = NULL;
+    from->bumpEnd = NULL;
+    from->mergedInto = into;
+    into->users++;
+
+    return success;
+}
+
+
+status reserveInPool(MemoryPool pool, size_t count) {
+    // Check if the pool is NULL
+    if (pool == NULL) {
+        return failure;
+    }
+    pool = activePool(pool);
+
+    // Count the objects that can be handed out without a new slab
+    size_t available = pool->freeCount + (size_t)(pool->bumpEnd - pool->bump) / pool->objectSize;
+    if (available >= count) {
+        return success;
+    }
+
+    // A regular slab may be too small for the shortfall; grow just this one slab
+    size_t regularObjects = pool->nextSlabObjects;
+    if (regularObjects >= count - available) {
+        return addSlab(pool);
+    }
+    pool->nextSlabObjects = count - available;
+    status result = addSlab(pool);
+    pool->nextSlabObjects = regularObjects; // Later slabs keep the usual growth
+    return result;
+}
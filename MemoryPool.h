@@ -0,0 +1,54 @@
+//
+// Slab allocator for fixed-size objects such as linked list nodes.
+//
+
+#ifndef MEMORYPOOL_H
+#define MEMORYPOOL_H
+#include "Defs.h"
+
+typedef struct Memory_Pool *MemoryPool; // Defines MemoryPool as a pointer to a Memory_Pool structure
+
+// Function to create a pool that hands out objects of one fixed size
+// Objects are carved from slabs whose size doubles (4, 8, 16, ... objects) up to about 1 MiB,
+// and released objects are kept on an intrusive free list for reuse
+// objectSize: The size in bytes of every object the pool hands out
+// Returns: The new pool, or NULL if objectSize is 0 or memory allocation failed
+MemoryPool createMemoryPool(size_t objectSize);
+
+// Function to destroy a pool, releasing every slab at once
+// A pool shared with shareMemoryPool is only torn down when its last user destroys it;
+// objects still in use then become invalid and their contents are not visited
+// pool: The pool to destroy
+status destroyMemoryPool(MemoryPool pool);
+
+// Function to register one more user of a pool (for example a list that took over some of its nodes)
+// Every user calls destroyMemoryPool once when done
+// pool: The pool to share
+// Returns: The same pool
+MemoryPool shareMemoryPool(MemoryPool pool);
+
+// Function to merge the memory of one pool into another in O(1)
+// Afterwards both handles refer to the same memory: objects of either pool may be released to either handle,
+// and the slabs are freed once every user of both handles has destroyed its handle
+// into: The pool that takes over the memory
+// from: The pool whose memory is taken over; it must hand out objects of the same size
+status mergeMemoryPools(MemoryPool into, MemoryPool from);
+
+// Function to make sure the next `count` allocations from the pool succeed without calling malloc
+// pool: The pool to reserve objects in
+// count: The number of objects that will be allocated
+// Returns: failure if the pool could not grow, in which case nothing was reserved
+status reserveInPool(MemoryPool pool, size_t count);
+
+// Function to get an object from the pool
+// Reuses a released object if there is one and only calls malloc when a new slab is needed
+// pool: The pool to allocate from
+// Returns: Uninitialized memory of the pool's object size, or NULL if memory allocation failed
+void* allocateFromPool(MemoryPool pool);
+
+// Function to give an object back to the pool so later allocations can reuse it
+// pool: The pool the object was allocated from
+// object: The object to release
+status releaseToPool(MemoryPool pool, void* object);
+
+#endif //MEMORYPOOL_H
@@ -0,0 +1,133 @@
+//
+// Lock-free multi-producer / single-consumer queue for handing elements from several threads to one owner thread.
+//
+#include <stdatomic.h>
+#include <stdlib.h>
+#include "MpscQueue.h"
+
+#define CACHE_LINE_SIZE 64 // Producers and the consumer work on different cache lines
+
+// Definition of a queue node
+typedef struct Mpsc_Node {
+    _Atomic(struct Mpsc_Node*) next; // Next node, published by the producer that pushed it
+    Element element;                 // The queued element (unused in the current front node)
+} MpscNode;
+
+// Definition of the Mpsc_Queue structure
+// The front node is always a dummy whose element was already taken; the first real element sits in its successor
+struct Mpsc_Queue {
+    _Alignas(CACHE_LINE_SIZE) _Atomic(MpscNode*) tail; // Last node; producers exchange it
+    _Alignas(CACHE_LINE_SIZE) MpscNode* head;          // Dummy front node; only the consumer touches it
+    FreeFunction free_func;                            // Function for freeing elements left in the queue
+};
+
+
+MpscQueue createMpscQueue(FreeFunction free_func) {
+    // Allocate memory for the queue and its first dummy node
+    MpscQueue queue = (MpscQueue)aligned_alloc(CACHE_LINE_SIZE, sizeof(struct Mpsc_Queue));
+    if (!queue) { // Check if memory allocation failed
+        return NULL;
+    }
+    MpscNode* dummy = (MpscNode*)malloc(sizeof(MpscNode));
+    if (!dummy) { // Check if memory allocation failed
+        free(queue);
+        return NULL;
+    }
+
+    // Head and tail both start on the dummy node
+    atomic_init(&dummy->next, NULL);
+    dummy->element = NULL;
+    atomic_init(&queue->tail, dummy);
+    queue->head = dummy;
+    queue->free_func = free_func;
+
+    return queue;
+}
+
+
+status destroyMpscQueue(MpscQueue queue) {
+    // Check if the queue is NULL
+    if (queue == NULL) {
+        return failure;
+    }
+
+    // Free the elements still queued, then the dummy node
+    Element element;
+    while ((element = popFromMpscQueue(queue)) != NULL) {
+        if (queue->free_func != NULL) {
+            queue->free_func(element);
+        }
+    }
+    free(queue->head);
+
+    free(queue); // Free the queue structure itself
+    return success;
+}
+
+
+status pushToMpscQueue(MpscQueue queue, Element element) {
+    // Check the inputs; NULL is reserved for "queue empty"
+    if (queue == NULL || element == NULL) {
+        return failure;
+    }
+
+    // Create the node that will carry the element
+    MpscNode* new_node = (MpscNode*)malloc(sizeof(MpscNode));
+    if (!new_node) { // Check if memory allocation failed
+        return failure;
+    }
+    atomic_store_explicit(&new_node->next, NULL, memory_order_relaxed);
+    new_node->element = element;
+
+    // Claim the tail position with one exchange, then link the previous tail to the new node.
+    // Until that store lands the consumer simply sees the queue end at the previous node.
+    MpscNode* previous = atomic_exchange_explicit(&queue->tail, new_node, memory_order_acq_rel);
+    atomic_store_explicit(&previous->next, new_node, memory_order_release);
+
+    return success;
+}
+
+
+Element popFromMpscQueue(MpscQueue queue) {
+    // Check if the queue is NULL
+    if (queue == NULL) {
+        return NULL;
+    }
+
+    // The first element lives in the successor of the dummy front node
+    MpscNode* front = queue->head;
+    MpscNode* next = atomic_load_explicit(&front->next, memory_order_acquire);
+    if (next == NULL) {
+        return NULL; // Nothing has been linked after the front node yet
+    }
+
+    // The successor becomes the new dummy; the old one is no longer reachable by producers
+    Element element = next->element;
+    next->element = NULL;
+    queue->head = next;
+    free(front);
+
+    return element;
+}
+
+
+int drainMpscQueue(MpscQueue queue, VisitFunction visit, Element context, int maxCount) {
+    // Check the inputs
+    if (queue == NULL || visit == NULL || maxCount < 0) {
+        return -1;
+    }
+
+    // Take elements until the queue runs dry, the batch is full, or the visitor fails
+    int taken = 0;
+    while (maxCount == 0 || taken < maxCount) {
+        Element element = popFromMpscQueue(queue);
+        if (element == NULL) {
+            break;
+        }
+        taken++;
+        if (visit(element, context) == failure) {
+            break;
+        }
+    }
+    return taken;
+}
@@ -0,0 +1,41 @@
+//
+// Lock-free multi-producer / single-consumer queue for handing elements from several threads to one owner thread.
+//
+
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+#include "Defs.h"
+
+typedef struct Mpsc_Queue *MpscQueue; // Defines MpscQueue as a pointer to a Mpsc_Queue structure
+
+// Function to create an empty queue
+// free_func: A function to free memory for elements still queued when the queue is destroyed
+// Returns: The new queue, or NULL if memory allocation failed
+MpscQueue createMpscQueue(FreeFunction free_func);
+
+// Function to destroy a queue, freeing the elements still in it
+// Must only be called once no producer can push anymore
+// queue: The queue to destroy
+status destroyMpscQueue(MpscQueue queue);
+
+// Function to add an element at the end of the queue; safe to call from any number of threads at once
+// A push is a single atomic exchange of the tail plus one store; it never waits for other threads
+// queue: The queue
+// element: The element to add (must not be NULL)
+status pushToMpscQueue(MpscQueue queue, Element element);
+
+// Function to take the element at the front of the queue; only the consumer thread may call it
+// queue: The queue
+// Returns: The element, or NULL if the queue is empty (or the next push has not finished linking yet)
+Element popFromMpscQueue(MpscQueue queue);
+
+// Function to take up to maxCount elements from the front of the queue and hand each one to a visitor, in order
+// Only the consumer thread may call it; the visitor takes ownership of each element it receives
+// queue: The queue
+// visit: The function called for each element taken
+// context: An arbitrary pointer handed to every call of visit
+// maxCount: The largest number of elements to take, or 0 to take everything that is available
+// Returns: The number of elements taken, or -1 if an argument is invalid (the drain also stops when visit fails)
+int drainMpscQueue(MpscQueue queue, VisitFunction visit, Element context, int maxCount);
+
+#endif //MPSCQUEUE_H
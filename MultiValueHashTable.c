@@ -86,6 +86,10 @@ struct MultiHashTable {
     TransformIntoNumberFunction transformIntoNumber;
     // Function pointer to hash a key into a numeric value.
     // This numeric value is used to determine the bucket where the key-value pair is stored.
+
+    MemoryPool valueNodes;
+    // Node pool shared by the value lists of every key.
+    // Most keys hold a few values, so one pool keeps them from each paying for a pool and a first slab.
 };
 
 
@@ -137,6 +141,14 @@ hashTableProMax createHashTableProMax(
         return NULL; // Return NULL to indicate failure.
     }
 
+    // Create the node pool the value lists share.
+    table->valueNodes = createListNodePool(LIST_LAYOUT_DOUBLE);
+    if (!table->valueNodes) {
+        destroyHashTable(table->hashTable);
+        free(table);
+        return NULL;
+    }
+
     // Initialize the fields of the MultiHashTable with the provided function pointers.
     table->copy_key = copyKey;
     table->free_key = freeKey;
@@ -167,6 +179,9 @@ status destroyHashTableProMax(hashTableProMax table) {
     //   for each key-value pair stored in the hash table.
     destroyHashTable(table->hashTable);
 
+    // Release the value lists' node pool once every list has given its nodes back.
+    destroyMemoryPool(table->valueNodes);
+
     // Free the memory allocated for the MultiHashTable structure itself.
     free(table);
 
@@ -175,6 +190,63 @@ status destroyHashTableProMax(hashTableProMax table) {
 }
 
 
+/*
+ * reserveHashTableProMax:
+ * Grows the internal hash table to hold 'keys' keys without resizing again.
+ * The value lists are untouched; only the pairs holding them move to the new buckets.
+ */
+status reserveHashTableProMax(hashTableProMax table, int keys) {
+    // Validate input parameters.
+    if (!table) {
+        return failure; // Invalid input.
+    }
+    return reserveHashTable(table->hashTable, keys);
+}
+
+
+/*
+ * enableHashTableProMaxFilter:
+ * Puts a Bloom filter in front of the internal hash table. Keys whose last value is removed
+ * leave the internal table too, so the filter keeps up with them.
+ */
+status enableHashTableProMaxFilter(hashTableProMax table) {
+    // Validate input parameters.
+    if (!table) {
+        return failure; // Invalid input.
+    }
+    return enableHashTableFilter(table->hashTable);
+}
+
+
+/*
+ * getHashTableProMaxStats / displayHashTableProMaxStats / sampleHashTableProMaxLookups:
+ * Diagnostics of the internal hash table, whose lookups are the ones every operation here starts with.
+ */
+status getHashTableProMaxStats(hashTableProMax table, HashTableStats* stats) {
+    // Validate input parameters.
+    if (!table) {
+        return failure; // Invalid input.
+    }
+    return getHashTableStats(table->hashTable, stats);
+}
+
+status displayHashTableProMaxStats(hashTableProMax table) {
+    // Validate input parameters.
+    if (!table) {
+        return failure; // Invalid input.
+    }
+    return displayHashTableStats(table->hashTable);
+}
+
+status sampleHashTableProMaxLookups(hashTableProMax table, int period) {
+    // Validate input parameters.
+    if (!table) {
+        return failure; // Invalid input.
+    }
+    return sampleHashTableLookups(table->hashTable, period);
+}
+
+
 /*
  * Returns the LinkedList of user-values associated with the given 'key',
  * or NULL if the key is not found in the hash table.
@@ -216,9 +288,30 @@ Element lookupInHashTableProMax(hashTableProMax table, Element key) {
  * - failure: If an error occurs (e.g., memory allocation failure).
  */
 status addToHashTableProMax(hashTableProMax table, Element key, Element value) {
+    node handle; // The handle of the new value node is not needed by plain callers.
+    return addToHashTableProMaxWithHandle(table, key, value, &handle);
+}
+
+
+/*
+ * addToHashTableProMaxWithHandle:
+ * Same as addToHashTableProMax, and also returns the handle of the node that now holds the value,
+ * so the value can later be removed with removeHandleFromHashTableProMax without searching the list.
+ *
+ * Parameters:
+ * - table: Pointer to the MultiHashTable.
+ * - key: The key to associate the value with.
+ * - value: The value to add.
+ * - handle: Receives the handle of the value's node in the key's list.
+ *
+ * Returns:
+ * - success: If the value is added successfully.
+ * - failure: If an error occurs (e.g., memory allocation failure).
+ */
+status addToHashTableProMaxWithHandle(hashTableProMax table, Element key, Element value, node* handle) {
     // Validate input parameters.
-    // Ensure that the table, key, and value are not NULL.
-    if (!table || !key || !value) {
+    // Ensure that the table, key, value and handle are not NULL.
+    if (!table || !key || !value || !handle) {
         return failure; // Invalid input.
     }
 
@@ -234,7 +327,7 @@ status addToHashTableProMax(hashTableProMax table, Element key, Element value) {
         }
 
         // Append the copied value to the existing LinkedList.
-        if (appendNode(existingValList, valueCopy) == failure) {
+        if (appendNodeWithHandle(existingValList, valueCopy, handle) == failure) {
             table->free_value(valueCopy); // Free the value copy on failure.
             return failure;
         }
@@ -244,7 +337,10 @@ status addToHashTableProMax(hashTableProMax table, Element key, Element value) {
     // If the key does not exist, create a new LinkedList and add the value.
     else {
         // Create a new LinkedList to hold the values associated with the key.
-        existingValList = createLinkedList(table->free_value, table->equal_value, table->print_value);
+        // Value lists are doubly linked so a single value can be removed through its handle in O(1),
+        // and take their nodes from the pool all of them share.
+        existingValList = createLinkedListInPool(table->free_value, table->equal_value, table->print_value,
+                                                 LIST_LAYOUT_DOUBLE, table->valueNodes);
         if (!existingValList) { // Check for memory allocation failure.
             return failure;
         }
@@ -257,7 +353,7 @@ status addToHashTableProMax(hashTableProMax table, Element key, Element value) {
         }
 
         // Append the copied value to the new LinkedList.
-        if (appendNode(existingValList, valueCopy) == failure) {
+        if (appendNodeWithHandle(existingValList, valueCopy, handle) == failure) {
             table->free_value(valueCopy); // Free the value copy on failure.
             destroyLinkedList(existingValList); // Free the LinkedList on failure.
             return failure;
@@ -334,6 +430,47 @@ status removeFromHashTableProMax(hashTableProMax table, Element key, Element val
 }
 
 
+/*
+ * removeHandleFromHashTableProMax:
+ * Removes a single value from the list of `key`, using the handle returned when the value was added.
+ * - The node is unlinked in O(1); the list is not searched and equal_value is not called.
+ * - If the list becomes empty after the removal, the key is removed entirely.
+ *
+ * Parameters:
+ * - table: Pointer to the MultiHashTable.
+ * - key: The key whose list holds the value.
+ * - handle: The handle returned by addToHashTableProMaxWithHandle for that value.
+ *
+ * Returns:
+ * - success: If the value was removed successfully.
+ * - failure: If an error occurs (e.g., invalid input, key not found).
+ */
+status removeHandleFromHashTableProMax(hashTableProMax table, Element key, node handle) {
+    // Validate input parameters.
+    if (!table || !key || !handle) {
+        return failure; // Invalid input.
+    }
+
+    // Lookup the LinkedList associated with the given key in the hash table.
+    LinkedList existingValList = (LinkedList)lookupInHashTable(table->hashTable, key);
+    if (!existingValList) {
+        return failure; // Key not found.
+    }
+
+    // Unlink the value's node directly through its handle.
+    if (deleteNodeByHandle(existingValList, handle) == failure) {
+        return failure;
+    }
+
+    // If the LinkedList becomes empty after the removal, remove the key entirely.
+    if (getLength(existingValList) == 0) {
+        return removeFromHashTable(table->hashTable, key);
+    }
+
+    return success;
+}
+
+
 /*
  * displayHashTableProMaxElementsByKey:
  * Displays the key and its associated list of values in the MultiHashTable.
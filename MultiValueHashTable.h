@@ -8,6 +8,7 @@
 
 #include "Defs.h"        // Includes definitions of required types and functions.
 #include "HashTable.h"   // Includes the base hash table functionality.
+#include "LinkedList.h"  // Includes the node handles of the per-key value lists.
 
 typedef struct MultiHashTable *hashTableProMax;
 // Defines a pointer to the structure representing the MultiValue Hash Table.
@@ -49,6 +50,40 @@ hashTableProMax createHashTableProMax(
 // Returns a status code indicating success or failure.
 status destroyHashTableProMax(hashTableProMax table);
 
+// Grows the MultiValue Hash Table at once so it holds the given number of keys without resizing.
+// Parameters:
+// - table: Pointer to the hash table.
+// - keys: The number of distinct keys expected.
+// Returns a status code indicating success or failure.
+status reserveHashTableProMax(hashTableProMax table, int keys);
+
+// Puts a Bloom filter in front of the internal hash table (see enableHashTableFilter),
+// so lookups of keys that have no values mostly return NULL without reading the buckets.
+// Parameters:
+// - table: Pointer to the hash table.
+// Returns a status code indicating success or failure.
+status enableHashTableProMaxFilter(hashTableProMax table);
+
+// Fills in the statistics of the internal hash table (see getHashTableStats); its entries are the distinct keys.
+// Parameters:
+// - table: Pointer to the hash table.
+// - stats: Receives the statistics.
+// Returns a status code indicating success or failure.
+status getHashTableProMaxStats(hashTableProMax table, HashTableStats* stats);
+
+// Prints the statistics of the internal hash table (see displayHashTableStats).
+// Parameters:
+// - table: Pointer to the hash table.
+// Returns a status code indicating success or failure.
+status displayHashTableProMaxStats(hashTableProMax table);
+
+// Samples the key compares of every period-th lookup of the internal hash table (see sampleHashTableLookups).
+// Parameters:
+// - table: Pointer to the hash table.
+// - period: Lookups per sample, or 0 to stop sampling.
+// Returns a status code indicating success or failure.
+status sampleHashTableProMaxLookups(hashTableProMax table, int period);
+
 // Adds a key-value pair to the MultiValue Hash Table.
 // Parameters:
 // - hashTableProMax: Pointer to the hash table.
@@ -57,6 +92,15 @@ status destroyHashTableProMax(hashTableProMax table);
 // Returns a status code indicating success or failure.
 status addToHashTableProMax(hashTableProMax hashTableProMax, Element key, Element value);
 
+// Adds a key-value pair like addToHashTableProMax and returns the handle of the value's node.
+// Parameters:
+// - hashTableProMax: Pointer to the hash table.
+// - key: The key to add or associate a value with.
+// - value: The value to associate with the key.
+// - handle: Receives the handle to pass to removeHandleFromHashTableProMax.
+// Returns a status code indicating success or failure.
+status addToHashTableProMaxWithHandle(hashTableProMax hashTableProMax, Element key, Element value, node* handle);
+
 // Looks up values associated with a key in the MultiValue Hash Table.
 // Parameters:
 // - hashTableProMax: Pointer to the hash table.
@@ -72,6 +116,14 @@ Element lookupInHashTableProMax(hashTableProMax hashTableProMax, Element key);
 // Returns a status code indicating success or failure.
 status removeFromHashTableProMax(hashTableProMax hashTableProMax, Element key, Element value);
 
+// Removes one value of a key in O(1) using the handle returned when it was added.
+// Parameters:
+// - hashTableProMax: Pointer to the hash table.
+// - key: The key whose associated value needs to be removed.
+// - handle: The handle returned by addToHashTableProMaxWithHandle for that value.
+// Returns a status code indicating success or failure.
+status removeHandleFromHashTableProMax(hashTableProMax hashTableProMax, Element key, node handle);
+
 // Displays all values associated with a specific key in the MultiValue Hash Table.
 // Parameters:
 // - hashTableProMax: Pointer to the hash table.
@@ -0,0 +1,322 @@
+//
+// Sorted container implemented as a skip list.
+//
+#include <stdlib.h>
+#include <stdio.h>
+#include "SortedList.h"
+#include "MemoryPool.h"
+
+#define SORTED_MAX_LEVEL 20   // Maximum number of levels; plenty for 4^20 elements with p = 1/4
+
+// Definition of the Sorted_Node structure
+struct Sorted_Node {
+    Element element;                 // The element stored in the node
+    int height;                      // Number of levels this node takes part in (1..SORTED_MAX_LEVEL)
+    struct Sorted_Node* forward[];   // forward[i] is the next node on level i
+};
+
+// Definition of the Sorted_List structure
+struct Sorted_List {
+    sortedNode head;            // Sentinel node with SORTED_MAX_LEVEL levels; holds no element
+    int level;                  // Number of levels currently in use
+    int size;                   // The number of elements in the list
+    unsigned int seed;          // State of the random generator choosing node heights
+    FreeFunction free_func;     // Function pointer for freeing the memory of elements
+    CompareFunction compare_func; // Function pointer for ordering two elements
+    PrintFunction print_func;   // Function pointer for printing an element
+    MemoryPool pools[SORTED_MAX_LEVEL]; // pools[h - 1] hands out nodes of height h (created on first use)
+};
+
+
+SortedList createSortedList(FreeFunction free_func, CompareFunction compare_func, PrintFunction print_func) {
+    // Validate the function pointers
+    if (!free_func || !compare_func || !print_func) {
+        return NULL;
+    }
+
+    // Allocate memory for a new Sorted_List structure
+    SortedList list = (SortedList)malloc(sizeof(struct Sorted_List));
+    if (!list) { // Check if memory allocation failed
+        return NULL;
+    }
+
+    // Allocate the sentinel head with a pointer for every possible level
+    list->head = (sortedNode)malloc(sizeof(struct Sorted_Node) + SORTED_MAX_LEVEL * sizeof(sortedNode));
+    if (!list->head) {
+        free(list);
+        return NULL;
+    }
+    list->head->element = NULL;
+    list->head->height = SORTED_MAX_LEVEL;
+    for (int i = 0; i < SORTED_MAX_LEVEL; i++) {
+        list->head->forward[i] = NULL; // Every level starts empty
+        list->pools[i] = NULL;         // Node pools are created on the first node of each height
+    }
+
+    // Initialize the list's properties
+    list->level = 1;
+    list->size = 0;
+    list->seed = 2463534242u; // Fixed seed, so node heights (and timings) are reproducible
+    list->free_func = free_func;
+    list->compare_func = compare_func;
+    list->print_func = print_func;
+
+    return list;
+}
+
+
+status destroySortedList(SortedList list) {
+    // Check if the list is NULL
+    if (list == NULL) {
+        return failure;
+    }
+
+    // Free every element by walking the bottom level, which links all nodes
+    for (sortedNode current = list->head->forward[0]; current != NULL; current = current->forward[0]) {
+        list->free_func(current->element);
+    }
+
+    // Release the nodes of each height at once through their pools
+    for (int i = 0; i < SORTED_MAX_LEVEL; i++) {
+        if (list->pools[i] != NULL) {
+            destroyMemoryPool(list->pools[i]);
+        }
+    }
+
+    free(list->head); // Free the sentinel
+    free(list);       // Free the list structure itself
+    return success;
+}
+
+
+/*
+ * randomHeight:
+ * Chooses the height of a new node: each additional level is taken with probability 1/4.
+ * Uses a xorshift generator kept in the list, so no global state is touched.
+ */
+static int randomHeight(SortedList list) {
+    int height = 1;
+    while (height < SORTED_MAX_LEVEL) {
+        // Advance the xorshift32 generator
+        list->seed ^= list->seed << 13;
+        list->seed ^= list->seed >> 17;
+        list->seed ^= list->seed << 5;
+        if ((list->seed & 3u) != 0) {
+            break; // Three times out of four the node stops growing
+        }
+        height++;
+    }
+    return height;
+}
+
+
+/*
+ * findPredecessors:
+ * Fills update[i] with the last node on level i whose element is strictly less than `key`
+ * (or, when `includeEqual` is true, less than or equal to `key`).
+ */
+static void findPredecessors(SortedList list, Element key, bool includeEqual, sortedNode update[]) {
+    sortedNode current = list->head;
+
+    // Descend from the highest level in use, moving right while the next element comes before the key
+    for (int i = list->level - 1; i >= 0; i--) {
+        while (current->forward[i] != NULL) {
+            int order = list->compare_func(current->forward[i]->element, key);
+            if (order < 0 || (includeEqual && order == 0)) {
+                current = current->forward[i];
+            } else {
+                break;
+            }
+        }
+        update[i] = current;
+    }
+
+    // Levels above the ones in use start at the sentinel
+    for (int i = list->level; i < SORTED_MAX_LEVEL; i++) {
+        update[i] = list->head;
+    }
+}
+
+
+status insertToSortedList(SortedList list, Element element) {
+    // Validate the inputs
+    if (list == NULL) {
+        return failure;
+    }
+
+    // Find where the element goes: after every element that is less than or equal to it
+    sortedNode update[SORTED_MAX_LEVEL];
+    findPredecessors(list, element, true, update);
+
+    // Take a node of a random height from the pool for that height
+    int height = randomHeight(list);
+    if (list->pools[height - 1] == NULL) {
+        list->pools[height - 1] = createMemoryPool(sizeof(struct Sorted_Node) + (size_t)height * sizeof(sortedNode));
+        if (list->pools[height - 1] == NULL) {
+            return failure; // Check if memory allocation failed
+        }
+    }
+    sortedNode new_node = (sortedNode)allocateFromPool(list->pools[height - 1]);
+    if (new_node == NULL) {
+        return failure; // Check if memory allocation failed
+    }
+    new_node->element = element;
+    new_node->height = height;
+
+    // Splice the node into every level it takes part in
+    for (int i = 0; i < height; i++) {
+        new_node->forward[i] = update[i]->forward[i];
+        update[i]->forward[i] = new_node;
+    }
+    if (height > list->level) {
+        list->level = height; // The list now uses more levels
+    }
+
+    list->size++;
+    return success;
+}
+
+
+status deleteFromSortedList(SortedList list, Element element) {
+    // Validate the inputs
+    if (list == NULL || list->size == 0) {
+        return failure;
+    }
+
+    // Find the predecessors of the first element that is not less than the given one
+    sortedNode update[SORTED_MAX_LEVEL];
+    findPredecessors(list, element, false, update);
+    sortedNode first = update[0]->forward[0];
+    if (first == NULL || list->compare_func(first->element, element) != 0) {
+        return failure; // No element compares equal
+    }
+
+    // Look for the identical pointer among the equal elements; every node passed over becomes
+    // the predecessor on the levels it takes part in
+    sortedNode walkUpdate[SORTED_MAX_LEVEL];
+    for (int i = 0; i < SORTED_MAX_LEVEL; i++) {
+        walkUpdate[i] = update[i];
+    }
+    sortedNode target = first;
+    while (target != NULL && target->element != element && list->compare_func(target->element, element) == 0) {
+        for (int i = 0; i < target->height; i++) {
+            walkUpdate[i] = target;
+        }
+        target = target->forward[0];
+    }
+
+    // Use the identical element if it was found, otherwise the first equal one
+    sortedNode* predecessors = walkUpdate;
+    if (target == NULL || target->element != element) {
+        target = first;
+        predecessors = update;
+    }
+
+    // Unlink the node from every level it takes part in
+    for (int i = 0; i < target->height; i++) {
+        predecessors[i]->forward[i] = target->forward[i];
+    }
+    while (list->level > 1 && list->head->forward[list->level - 1] == NULL) {
+        list->level--; // Drop levels that became empty
+    }
+
+    // Free the element and return the node to the pool it came from
+    list->free_func(target->element);
+    releaseToPool(list->pools[target->height - 1], target);
+    list->size--;
+    return success;
+}
+
+
+SortedIterator sortedLowerBound(SortedList list, Element key) {
+    SortedIterator iterator;
+    iterator.current = NULL;
+    if (list == NULL) {
+        return iterator; // An invalid iterator for a missing list
+    }
+
+    // The first node after the strict predecessors is the lower bound
+    sortedNode update[SORTED_MAX_LEVEL];
+    findPredecessors(list, key, false, update);
+    iterator.current = update[0]->forward[0];
+    return iterator;
+}
+
+
+Element searchInSortedList(SortedList list, Element key) {
+    // Check if the list is NULL
+    if (list == NULL) {
+        return NULL;
+    }
+
+    // The lower bound is the only candidate; it matches if it compares equal to the key
+    SortedIterator iterator = sortedLowerBound(list, key);
+    if (iterator.current != NULL && list->compare_func(iterator.current->element, key) == 0) {
+        return iterator.current->element;
+    }
+    return NULL;
+}
+
+
+SortedIterator sortedBegin(SortedList list) {
+    SortedIterator iterator;
+    iterator.current = list ? list->head->forward[0] : NULL; // The bottom level starts at the smallest element
+    return iterator;
+}
+
+
+bool sortedIteratorValid(const SortedIterator* iterator) {
+    return (iterator != NULL && iterator->current != NULL) ? true : false;
+}
+
+
+void sortedIteratorNext(SortedIterator* iterator) {
+    if (iterator != NULL && iterator->current != NULL) {
+        iterator->current = iterator->current->forward[0]; // Follow the bottom level
+    }
+}
+
+
+Element sortedIteratorData(const SortedIterator* iterator) {
+    return (iterator != NULL && iterator->current != NULL) ? iterator->current->element : NULL;
+}
+
+
+status forEachInSortedList(SortedList list, VisitFunction visit, Element context) {
+    // Check if the list or the visitor function is NULL
+    if (list == NULL || visit == NULL) {
+        return failure;
+    }
+
+    // Visit the elements in ascending order along the bottom level
+    sortedNode current = list->head->forward[0];
+    while (current != NULL) {
+        sortedNode next = current->forward[0]; // Save the next node in case the visitor deletes this one
+        if (visit(current->element, context) == failure) {
+            return failure; // Stop as soon as the visitor reports failure
+        }
+        current = next;
+    }
+
+    return success;
+}
+
+
+status displaySortedList(SortedList list) {
+    // Check if the list is NULL
+    if (list == NULL) {
+        return failure;
+    }
+
+    // Print the elements in ascending order
+    for (sortedNode current = list->head->forward[0]; current != NULL; current = current->forward[0]) {
+        list->print_func(current->element);
+    }
+    return success;
+}
+
+
+int getSortedListLength(SortedList list) {
+    // Return -1 for a missing list, like getLength does
+    return list ? list->size : -1;
+}
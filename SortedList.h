@@ -0,0 +1,85 @@
+//
+// Sorted container implemented as a skip list.
+// Keeps its elements ordered by a comparator, so ordered listings need no separate sort.
+//
+
+#ifndef SORTEDLIST_H
+#define SORTEDLIST_H
+#include "Defs.h"
+
+typedef struct Sorted_List *SortedList;     // Defines SortedList as a pointer to a Sorted_List structure
+typedef struct Sorted_Node *sortedNode;     // Defines sortedNode as a pointer to a Sorted_Node structure
+
+// Cursor over the elements of a sorted list, in ascending order
+typedef struct Sorted_Iterator {
+    sortedNode current;   // The node the iterator stands on (NULL once past the end)
+} SortedIterator;
+
+// Function to create an empty sorted list
+// free_func: A function to free memory for elements in the list
+// compare_func: A function ordering two elements (negative, 0 or positive, like strcmp)
+// print_func: A function to print an element
+SortedList createSortedList(FreeFunction free_func, CompareFunction compare_func, PrintFunction print_func);
+
+// Function to destroy a sorted list and free all associated memory
+// list: A pointer to the sorted list
+status destroySortedList(SortedList list);
+
+// Function to insert an element at its place in the order, in O(log n) expected time
+// Elements that compare equal keep their insertion order
+// list: A pointer to the sorted list
+// element: The element to be added
+status insertToSortedList(SortedList list, Element element);
+
+// Function to delete an element from the sorted list, in O(log n) expected time
+// Among the elements comparing equal to `element`, the identical pointer is deleted if it is present,
+// otherwise the first equal one; the deleted element is freed with the list's free function
+// list: A pointer to the sorted list
+// element: The element to be deleted
+status deleteFromSortedList(SortedList list, Element element);
+
+// Function to find the first element that compares equal to a key
+// list: A pointer to the sorted list
+// key: The key to search for (passed to compare_func as its second argument)
+// Returns: The element, or NULL if no element compares equal
+Element searchInSortedList(SortedList list, Element key);
+
+// Function to position an iterator on the first element that is not less than a key, in O(log n)
+// list: A pointer to the sorted list
+// key: The key to search for (passed to compare_func as its second argument)
+// Returns: An iterator that is invalid if every element is less than the key
+SortedIterator sortedLowerBound(SortedList list, Element key);
+
+// Function to get an iterator positioned on the smallest element
+// list: A pointer to the sorted list
+SortedIterator sortedBegin(SortedList list);
+
+// Function to check whether an iterator still points at an element
+// iterator: A pointer to the iterator
+bool sortedIteratorValid(const SortedIterator* iterator);
+
+// Function to advance an iterator to the next larger element in O(1)
+// iterator: A pointer to the iterator
+void sortedIteratorNext(SortedIterator* iterator);
+
+// Function to get the element the iterator currently points at
+// iterator: A pointer to the iterator
+// Returns: The current element, or NULL if the iterator is invalid
+Element sortedIteratorData(const SortedIterator* iterator);
+
+// Function to call a visitor for every element in ascending order
+// list: A pointer to the sorted list
+// visit: The function called for each element
+// context: An arbitrary pointer handed to every call of visit
+// Returns: failure if the list or visitor is NULL or if visit returned failure (the traversal stops there)
+status forEachInSortedList(SortedList list, VisitFunction visit, Element context);
+
+// Function to print all elements in ascending order
+// list: A pointer to the sorted list
+status displaySortedList(SortedList list);
+
+// Function to get the number of elements in the sorted list
+// list: A pointer to the sorted list
+int getSortedListLength(SortedList list);
+
+#endif //SORTEDLIST_H
@@ -0,0 +1,135 @@
+//
+// Persistent pool of worker threads for splitting a pass over a container into parallel tasks.
+//
+#include <pthread.h>
+#include <stdint.h>
+#include "WorkerPool.h"
+
+static pthread_mutex_t g_runLock = PTHREAD_MUTEX_INITIALIZER;  // Allows one run (or shutdown) at a time
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;     // Protects everything below
+static pthread_cond_t g_workReady = PTHREAD_COND_INITIALIZER;  // Signalled when a run starts or workers must stop
+static pthread_cond_t g_workDone = PTHREAD_COND_INITIALIZER;   // Signalled when the last task of a run finishes
+static pthread_t g_workers[MAX_WORKER_THREADS];                 // The worker threads started so far
+static int g_workerCount = 0;       // Number of entries of g_workers in use
+static unsigned long g_generation = 0; // Incremented for every run, so workers can tell a new run from a spurious wakeup
+static bool g_stopping = false;     // Set while shutdownWorkerPool asks the workers to exit
+static TaskFunction g_task = NULL;  // Task function of the current run
+static Element g_argument = NULL;   // Argument of the current run
+static int g_taskCount = 0;         // Number of tasks in the current run
+static int g_nextTask = 0;          // Next task nobody has claimed yet
+static int g_unfinished = 0;        // Tasks of the current run that have not finished yet
+
+
+/*
+ * runPendingTasks:
+ * Claims and runs tasks of the current run until none is left. Called with g_lock held;
+ * the lock is released while a task runs.
+ */
+static void runPendingTasks(void) {
+    while (g_nextTask < g_taskCount) {
+        int taskIndex = g_nextTask++; // Claim the next task
+        pthread_mutex_unlock(&g_lock);
+        g_task(g_argument, taskIndex);
+        pthread_mutex_lock(&g_lock);
+        if (--g_unfinished == 0) {
+            pthread_cond_signal(&g_workDone); // Wake the thread that started the run
+        }
+    }
+}
+
+
+/*
+ * workerMain:
+ * Body of every worker thread: waits for a new run, helps with its tasks, and repeats until asked to stop.
+ * The argument is the generation that was current when the worker was started.
+ */
+static void* workerMain(void* startGeneration) {
+    unsigned long seen = (unsigned long)(uintptr_t)startGeneration;
+
+    pthread_mutex_lock(&g_lock);
+    while (true) {
+        // Sleep until a run newer than the last one this worker saw begins
+        while (!g_stopping && g_generation == seen) {
+            pthread_cond_wait(&g_workReady, &g_lock);
+        }
+        if (g_stopping) {
+            break;
+        }
+        seen = g_generation;
+        runPendingTasks();
+    }
+    pthread_mutex_unlock(&g_lock);
+    return NULL;
+}
+
+
+status runInParallel(TaskFunction task, Element argument, int taskCount, int threads) {
+    // Check the inputs
+    if (task == NULL || taskCount < 0) {
+        return failure;
+    }
+
+    // Without helpers (or with a single task) there is nothing to hand out
+    if (threads <= 1 || taskCount <= 1) {
+        for (int i = 0; i < taskCount; i++) {
+            task(argument, i);
+        }
+        return success;
+    }
+    if (threads > MAX_WORKER_THREADS) {
+        threads = MAX_WORKER_THREADS;
+    }
+
+    pthread_mutex_lock(&g_runLock);
+    pthread_mutex_lock(&g_lock);
+
+    // Start the workers this run needs (the caller counts as one thread); if that fails, fewer threads help
+    while (g_workerCount < threads - 1 &&
+           pthread_create(&g_workers[g_workerCount], NULL, workerMain, (void*)(uintptr_t)g_generation) == 0) {
+        g_workerCount++;
+    }
+
+    // Publish the run and wake the workers
+    g_task = task;
+    g_argument = argument;
+    g_taskCount = taskCount;
+    g_nextTask = 0;
+    g_unfinished = taskCount;
+    g_generation++;
+    pthread_cond_broadcast(&g_workReady);
+
+    // Work on the tasks alongside the workers, then wait for the ones still running elsewhere
+    runPendingTasks();
+    while (g_unfinished > 0) {
+        pthread_cond_wait(&g_workDone, &g_lock);
+    }
+    g_task = NULL;
+    g_argument = NULL;
+
+    pthread_mutex_unlock(&g_lock);
+    pthread_mutex_unlock(&g_runLock);
+    return success;
+}
+
+
+void shutdownWorkerPool(void) {
+    pthread_mutex_lock(&g_runLock);
+
+    // Ask every worker to exit
+    pthread_mutex_lock(&g_lock);
+    g_stopping = true;
+    pthread_cond_broadcast(&g_workReady);
+    pthread_mutex_unlock(&g_lock);
+
+    // Wait for them to finish
+    for (int i = 0; i < g_workerCount; i++) {
+        pthread_join(g_workers[i], NULL);
+    }
+
+    pthread_mutex_lock(&g_lock);
+    g_workerCount = 0;
+    g_stopping = false;
+    pthread_mutex_unlock(&g_lock);
+
+    pthread_mutex_unlock(&g_runLock);
+}
@@ -0,0 +1,27 @@
+//
+// Persistent pool of worker threads for splitting a pass over a container into parallel tasks.
+//
+
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+#include "Defs.h"
+
+#define MAX_WORKER_THREADS 64 // Upper bound on the number of threads that take part in one run
+
+typedef void (*TaskFunction)(Element argument, int taskIndex); // One task of a parallel run
+
+// Function to run task(argument, i) for every i from 0 to taskCount - 1 and wait until all of them finished
+// The calling thread works on tasks too, so at most threads - 1 worker threads are used;
+// workers are started on the first run that needs them and stay alive for later runs
+// Tasks must not call runInParallel themselves
+// task: The function to run
+// argument: An arbitrary pointer handed to every task
+// taskCount: The number of tasks
+// threads: The maximum number of threads working on the tasks at the same time (1 runs everything on the caller)
+status runInParallel(TaskFunction task, Element argument, int taskCount, int threads);
+
+// Function to stop and join all worker threads
+// A later runInParallel starts them again
+void shutdownWorkerPool(void);
+
+#endif //WORKERPOOL_H
@@ -0,0 +1,126 @@
+//
+// Batched against one-at-a-time lookups: every key of a table is looked up once in random order, either with
+// lookupInHashTable per key or with lookupManyInHashTable over chunks of keys (like resolving a pickup list).
+// Both backends are measured at each size; the larger sizes are meant to be well beyond the last-level cache.
+// Usage: BatchedLookupBench [entries ...]
+//
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../HashTable.h"
+
+#define CHUNK 1024 // Keys handed to lookupManyInHashTable per call
+
+static Element found[CHUNK];
+
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Keys are pointers into an array of numbers owned by the benchmark; the tables store them as they are
+static Element keepElement(Element element) {
+    return element;
+}
+
+static status forgetElement(Element element) {
+    (void)element;
+    return success;
+}
+
+static bool equalNumbers(Element first, Element second) {
+    return *(uint64_t*)first == *(uint64_t*)second;
+}
+
+static int hashNumber(Element key) {
+    uint64_t x = *(uint64_t*)key;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (int)(x & 0x7fffffff);
+}
+
+
+/*
+ * measure:
+ * Builds a table of the backend holding every number, then times looking all of them up in the order of queries,
+ * one at a time and in chunks. Prints both times per lookup.
+ */
+static void measure(HashBackend backend, uint64_t* numbers, Element* queries, int count) {
+    hashTable table = createHashTableWithBackend(keepElement, forgetElement, forgetElement, keepElement,
+                                                 forgetElement, forgetElement, equalNumbers, hashNumber, count,
+                                                 backend);
+    if (table == NULL) {
+        printf("Out of memory\n");
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        addToHashTable(table, &numbers[i], &numbers[i]);
+    }
+
+    long hits = 0;
+    double start = now();
+    for (int i = 0; i < count; i++) {
+        hits += lookupInHashTable(table, queries[i]) != NULL;
+    }
+    double single = now() - start;
+
+    start = now();
+    for (int first = 0; first < count; first += CHUNK) {
+        int n = count - first < CHUNK ? count - first : CHUNK;
+        hits += lookupManyInHashTable(table, &queries[first], n, found);
+    }
+    double batched = now() - start;
+
+    printf("%10d entries, %-7s: one at a time %6.1f ns, batched %6.1f ns per lookup (%.2fx)%s\n",
+           count, backend == HASH_BACKEND_OPEN ? "open" : "chained", single / count * 1e9, batched / count * 1e9,
+           single / batched, hits == 2L * count ? "" : " (keys missing!)");
+    destroyHashTable(table);
+}
+
+
+int main(int argc, char* argv[]) {
+    int defaultSizes[] = {1 << 16, 1 << 22};
+    int sizeCount = argc > 1 ? argc - 1 : 2;
+
+    for (int s = 0; s < sizeCount; s++) {
+        int count = argc > 1 ? atoi(argv[s + 1]) : defaultSizes[s];
+        if (count < 1) {
+            printf("Usage: %s [entries ...]\n", argv[0]);
+            return 1;
+        }
+
+        // Distinct numbers, looked up through copies in shuffled order so each lookup reads a random entry
+        uint64_t* numbers = (uint64_t*)malloc(count * sizeof(uint64_t));
+        uint64_t* copies = (uint64_t*)malloc(count * sizeof(uint64_t));
+        Element* queries = (Element*)malloc(count * sizeof(Element));
+        if (numbers == NULL || copies == NULL || queries == NULL) {
+            printf("Out of memory\n");
+            return 1;
+        }
+        srand(1);
+        for (int i = 0; i < count; i++) {
+            numbers[i] = (uint64_t)i * 0x9e3779b97f4a7c15ULL + 1;
+            copies[i] = numbers[i];
+        }
+        for (int i = count - 1; i > 0; i--) {
+            int j = (int)(((uint64_t)rand() * RAND_MAX + rand()) % (uint64_t)(i + 1));
+            uint64_t swap = copies[i];
+            copies[i] = copies[j];
+            copies[j] = swap;
+        }
+        for (int i = 0; i < count; i++) {
+            queries[i] = &copies[i];
+        }
+
+        measure(HASH_BACKEND_OPEN, numbers, queries, count);
+        measure(HASH_BACKEND_CHAINED, numbers, queries, count);
+        free(numbers);
+        free(copies);
+        free(queries);
+    }
+    return 0;
+}
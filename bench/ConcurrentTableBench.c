@@ -0,0 +1,148 @@
+//
+// Throughput of concurrentHashTable against one hashTable behind a global mutex (the only option before it),
+// from 1 to 32 threads at read/write mixes of 99/1, 90/10 and 50/50. Reads look up a random key; writes upsert
+// or remove one. The operations are split among the threads, so every run does the same total work.
+// Usage: ConcurrentTableBench [largest thread count] [total operations]
+//
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../ConcurrentHashTable.h"
+#include "../HashTable.h"
+
+#define KEYS (1 << 16)  // Keys the operations pick from; the tables start with all of them
+#define STRIPES 64
+
+static uint64_t numbers[KEYS];
+static int readPercent;
+static long operationsPerThread;
+static concurrentHashTable striped;
+static hashTable locked;
+static pthread_mutex_t tableLock = PTHREAD_MUTEX_INITIALIZER;
+
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Keys and values are pointers into numbers, owned by the benchmark; the tables store them as they are
+static Element keepElement(Element element) {
+    return element;
+}
+
+static status forgetElement(Element element) {
+    (void)element;
+    return success;
+}
+
+static bool equalNumbers(Element first, Element second) {
+    return *(uint64_t*)first == *(uint64_t*)second;
+}
+
+static int hashNumber(Element key) {
+    uint64_t x = *(uint64_t*)key;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (int)(x & 0x7fffffff);
+}
+
+
+static void* stripedWorker(void* seed) {
+    unsigned int state = (unsigned int)(size_t)seed;
+    for (long i = 0; i < operationsPerThread; i++) {
+        uint64_t* key = &numbers[rand_r(&state) % KEYS];
+        int choice = rand_r(&state) % 100;
+        if (choice < readPercent) {
+            lookupInConcurrentHashTable(striped, key);
+        } else if (choice % 2 == 0) {
+            upsertConcurrentHashTable(striped, key, key, NULL);
+        } else {
+            removeFromConcurrentHashTable(striped, key);
+        }
+    }
+    return NULL;
+}
+
+static void* lockedWorker(void* seed) {
+    unsigned int state = (unsigned int)(size_t)seed;
+    for (long i = 0; i < operationsPerThread; i++) {
+        uint64_t* key = &numbers[rand_r(&state) % KEYS];
+        int choice = rand_r(&state) % 100;
+        pthread_mutex_lock(&tableLock);
+        if (choice < readPercent) {
+            lookupInHashTable(locked, key);
+        } else if (choice % 2 == 0) {
+            upsertHashTable(locked, key, key, NULL);
+        } else {
+            removeFromHashTable(locked, key);
+        }
+        pthread_mutex_unlock(&tableLock);
+    }
+    return NULL;
+}
+
+
+/*
+ * run:
+ * Starts threads running worker on freshly filled tables and returns the millions of operations per second.
+ */
+static double run(void* (*worker)(void*), int threads, long operations) {
+    striped = createConcurrentHashTable(keepElement, forgetElement, keepElement, forgetElement, equalNumbers,
+                                        hashNumber, KEYS, STRIPES);
+    locked = createHashTableWithBackend(keepElement, forgetElement, forgetElement, keepElement, forgetElement,
+                                        forgetElement, equalNumbers, hashNumber, KEYS, HASH_BACKEND_OPEN);
+    if (striped == NULL || locked == NULL) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+    for (int i = 0; i < KEYS; i++) {
+        addToConcurrentHashTable(striped, &numbers[i], &numbers[i]);
+        addToHashTable(locked, &numbers[i], &numbers[i]);
+    }
+
+    operationsPerThread = operations / threads;
+    pthread_t ids[threads];
+    double start = now();
+    for (int i = 0; i < threads; i++) {
+        pthread_create(&ids[i], NULL, worker, (void*)(size_t)(i + 1));
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    double seconds = now() - start;
+
+    destroyConcurrentHashTable(striped);
+    destroyHashTable(locked);
+    return (double)operationsPerThread * threads / seconds / 1e6;
+}
+
+
+int main(int argc, char* argv[]) {
+    int largest = argc > 1 ? atoi(argv[1]) : 32;
+    long operations = argc > 2 ? atol(argv[2]) : 4000000;
+    if (largest < 1 || operations < largest) {
+        printf("Usage: %s [largest thread count] [total operations]\n", argv[0]);
+        return 1;
+    }
+    for (int i = 0; i < KEYS; i++) {
+        numbers[i] = (uint64_t)i * 0x9e3779b97f4a7c15ULL + 1;
+    }
+
+    int mixes[] = {99, 90, 50};
+    printf("M operations per second, %d keys, %d stripes\n", KEYS, STRIPES);
+    printf("threads  reads  striped  one mutex\n");
+    for (int m = 0; m < 3; m++) {
+        readPercent = mixes[m];
+        for (int threads = 1; threads <= largest; threads *= 2) {
+            double stripedRate = run(stripedWorker, threads, operations);
+            double lockedRate = run(lockedWorker, threads, operations);
+            printf("%7d  %4d%%  %7.2f  %9.2f\n", threads, readPercent, stripedRate, lockedRate);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+//
+// Hand-off throughput of MpscQueue against a LinkedList guarded by a mutex: several producer threads push
+// elements while one consumer takes them. The list's consumer moves everything queued so far out in one
+// spliceLists under the lock, the best a mutex-protected appendNode can do, so only the producers' side differs.
+// Usage: MpscQueueBench [producers] [elements per producer]
+//
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../MpscQueue.h"
+#include "../LinkedList.h"
+
+static int producers = 4;
+static int elements = 1000000;
+
+static MpscQueue queue;
+static LinkedList sharedList;
+static pthread_mutex_t listLock = PTHREAD_MUTEX_INITIALIZER;
+
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// The elements are small numbers cast to pointers, so neither side allocates or frees them
+static status keepElement(Element element) {
+    (void)element;
+    return success;
+}
+
+static bool sameElement(Element first, Element second) {
+    return first == second;
+}
+
+static status countElement(Element element, Element count) {
+    (void)element;
+    (*(long*)count)++;
+    return success;
+}
+
+
+static void* queueProducer(void* unused) {
+    (void)unused;
+    for (int i = 1; i <= elements; i++) {
+        pushToMpscQueue(queue, (Element)(size_t)i);
+    }
+    return NULL;
+}
+
+static void* listProducer(void* unused) {
+    (void)unused;
+    for (int i = 1; i <= elements; i++) {
+        pthread_mutex_lock(&listLock);
+        appendNode(sharedList, (Element)(size_t)i);
+        pthread_mutex_unlock(&listLock);
+    }
+    return NULL;
+}
+
+
+/*
+ * runQueue:
+ * Times the producers pushing to an MpscQueue while this thread drains it. Returns the seconds taken.
+ */
+static double runQueue(void) {
+    queue = createMpscQueue(keepElement);
+    pthread_t threads[producers];
+    long received = 0;
+    long expected = (long)producers * elements;
+
+    double start = now();
+    for (int i = 0; i < producers; i++) {
+        pthread_create(&threads[i], NULL, queueProducer, NULL);
+    }
+    while (received < expected) {
+        drainMpscQueue(queue, countElement, &received, 0);
+    }
+    double seconds = now() - start;
+
+    for (int i = 0; i < producers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    destroyMpscQueue(queue);
+    return seconds;
+}
+
+
+/*
+ * runList:
+ * Times the producers appending to a shared LinkedList under a mutex while this thread moves out and counts
+ * what they appended. Returns the seconds taken.
+ */
+static double runList(void) {
+    sharedList = createLinkedList(keepElement, sameElement, keepElement);
+    pthread_t threads[producers];
+    long received = 0;
+    long expected = (long)producers * elements;
+
+    double start = now();
+    for (int i = 0; i < producers; i++) {
+        pthread_create(&threads[i], NULL, listProducer, NULL);
+    }
+    while (received < expected) {
+        LinkedList batch = createLinkedList(keepElement, sameElement, keepElement);
+        pthread_mutex_lock(&listLock);
+        spliceLists(batch, sharedList);
+        pthread_mutex_unlock(&listLock);
+        forEachInList(batch, countElement, &received);
+        destroyLinkedList(batch);
+    }
+    double seconds = now() - start;
+
+    for (int i = 0; i < producers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    destroyLinkedList(sharedList);
+    return seconds;
+}
+
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        producers = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        elements = atoi(argv[2]);
+    }
+    if (producers < 1 || elements < 1) {
+        printf("Usage: %s [producers] [elements per producer]\n", argv[0]);
+        return 1;
+    }
+
+    double total = (double)producers * elements;
+    double queueSeconds = runQueue();
+    double listSeconds = runList();
+    printf("%d producers, %d elements each\n", producers, elements);
+    printf("MpscQueue              : %.3f s, %.1f M elements/s\n", queueSeconds, total / queueSeconds / 1e6);
+    printf("LinkedList under mutex : %.3f s, %.1f M elements/s\n", listSeconds, total / listSeconds / 1e6);
+    return 0;
+}
@@ -0,0 +1,148 @@
+//
+// Chain lengths and lookup cost of hashString against the character sum JerryBoreeMain used to hash IDs with.
+// The keys look like the Jerry IDs of the configuration files (4 to 6 digits and letters, e.g. "23dF21"), and every
+// fourth one is an anagram of an earlier key. Each hash fills a chained table with one bucket per key.
+// Usage: StringHashBench [keys]
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../HashTable.h"
+
+#define ROUNDS 10 // Lookups of every key per timing
+
+static const char idCharacters[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// The keys are owned by the benchmark; the table stores them as they are
+static Element keepElement(Element element) {
+    return element;
+}
+
+static status forgetElement(Element element) {
+    (void)element;
+    return success;
+}
+
+static bool equalKeys(Element first, Element second) {
+    return strcmp((char*)first, (char*)second) == 0;
+}
+
+// The hash JerryBoreeMain used before hashString
+static int sumOfCharacters(Element key) {
+    int sum = 0;
+    for (const char* c = (const char*)key; *c; c++) {
+        sum += (unsigned char)*c;
+    }
+    return sum;
+}
+
+
+/*
+ * makeKeys:
+ * Creates count distinct IDs; every fourth one shuffles the characters of an earlier ID.
+ */
+static char** makeKeys(int count) {
+    char** keys = (char**)malloc(count * sizeof(char*));
+    hashTable seen = createHashTable(keepElement, forgetElement, forgetElement, keepElement, forgetElement,
+                                     forgetElement, equalKeys, hashString, count);
+    if (keys == NULL || seen == NULL) {
+        free(keys);
+        destroyHashTable(seen);
+        return NULL;
+    }
+    char key[8];
+    for (int i = 0; i < count;) {
+        if (i % 4 == 3) {
+            strcpy(key, keys[rand() % i]);
+            int length = (int)strlen(key);
+            for (int j = length - 1; j > 0; j--) {
+                int k = rand() % (j + 1);
+                char c = key[j];
+                key[j] = key[k];
+                key[k] = c;
+            }
+        } else {
+            int length = 4 + rand() % 3;
+            for (int j = 0; j < length; j++) {
+                key[j] = idCharacters[rand() % (sizeof(idCharacters) - 1)];
+            }
+            key[length] = '\0';
+        }
+        if (lookupInHashTable(seen, key) != NULL) {
+            continue; // Already taken (an anagram of a key with repeated characters may be the key itself)
+        }
+        keys[i] = strdup(key);
+        addToHashTable(seen, keys[i], keys[i]);
+        i++;
+    }
+    destroyHashTable(seen);
+    return keys;
+}
+
+
+/*
+ * measure:
+ * Fills a chained table with the keys using the given hash, then prints its chain lengths,
+ * the key compares per lookup and the time of looking up every key ROUNDS times.
+ */
+static void measure(const char* name, TransformIntoNumberFunction hash, char** keys, int count) {
+    hashTable table = createHashTable(keepElement, forgetElement, forgetElement, keepElement, forgetElement,
+                                      forgetElement, equalKeys, hash, count);
+    if (table == NULL) {
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        addToHashTable(table, keys[i], keys[i]);
+    }
+    sampleHashTableLookups(table, 1);
+
+    int found = 0;
+    double start = now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < count; i++) {
+            found += lookupInHashTable(table, keys[i]) != NULL;
+        }
+    }
+    double seconds = now() - start;
+
+    HashTableStats stats;
+    getHashTableStats(table, &stats);
+    int empty = stats.lengths[0];
+    printf("%-18s: longest chain %5d, empty buckets %5.1f%%, compares per hit %8.2f, %6.1f ns per lookup%s\n",
+           name, stats.longest, 100.0 * empty / stats.buckets, stats.comparesPerHit,
+           seconds / ((double)ROUNDS * count) * 1e9, found == ROUNDS * count ? "" : " (keys missing!)");
+    destroyHashTable(table);
+}
+
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 20000;
+    if (count < 4) {
+        printf("Usage: %s [keys]\n", argv[0]);
+        return 1;
+    }
+
+    srand(1);
+    char** keys = makeKeys(count);
+    if (keys == NULL) {
+        printf("Out of memory\n");
+        return 1;
+    }
+    printf("%d Jerry-style IDs, one bucket per key\n", count);
+    measure("sum of characters", sumOfCharacters, keys, count);
+    measure("hashString", hashString, keys, count);
+
+    for (int i = 0; i < count; i++) {
+        free(keys[i]);
+    }
+    free(keys);
+    return 0;
+}
@@ -0,0 +1,111 @@
+//
+// Stress test for lookupManyInHashTable: reader threads resolve random batches of present, absent and NULL keys
+// against shared tables that nobody changes any more, in every shape a lookup can meet (chained and open
+// backends with their last resize still migrating, a frozen table, a table behind a Bloom filter). Every batch
+// must agree with the keys' known values. Build it with -fsanitize=thread or -fsanitize=address (make check);
+// a lookup that writes to the shared table, or reads past a batch, shows up there.
+//
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../HashTable.h"
+#include "TestCallbacks.h"
+
+#define READERS 4
+#define KEYS 5000          // Keys stored in every table; as many absent keys are looked up too
+#define ROUNDS 2000        // Batches per reader
+#define LARGEST_BATCH 300  // Batches hold 1 to LARGEST_BATCH keys, so they end both on and off the internal batch size
+#define TABLES 4
+
+static char keys[2 * KEYS][16];  // keys[i] is stored for i < KEYS, with the value &values[i]
+static int values[KEYS];
+static hashTable tables[TABLES];
+static atomic_int errors;
+
+
+/*
+ * createFilledTable:
+ * Creates a small table of the given backend and adds every stored key, so it grows several times on the way
+ * and its last resize is usually still moving entries when the readers start.
+ */
+static hashTable createFilledTable(HashBackend backend) {
+    hashTable table = createHashTableWithBackend(copyKey, freeKey, printElement, keepValue, forgetValue,
+                                                 printElement, equalKeys, hashString, 16, backend);
+    if (table == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < KEYS; i++) {
+        if (addToHashTable(table, keys[i], &values[i]) == failure) {
+            destroyHashTable(table);
+            return NULL;
+        }
+    }
+    return table;
+}
+
+
+static void* reader(void* seed) {
+    unsigned int state = (unsigned int)(size_t)seed;
+    Element batch[LARGEST_BATCH];
+    Element found[LARGEST_BATCH];
+    int index[LARGEST_BATCH];  // Which key each batch entry is, or -1 for a NULL key
+
+    for (int round = 0; round < ROUNDS; round++) {
+        hashTable table = tables[rand_r(&state) % TABLES];
+        int count = 1 + rand_r(&state) % LARGEST_BATCH;
+        int expectedFound = 0;
+        for (int i = 0; i < count; i++) {
+            index[i] = rand_r(&state) % 50 == 0 ? -1 : rand_r(&state) % (2 * KEYS);
+            batch[i] = index[i] < 0 ? NULL : keys[index[i]];
+            expectedFound += index[i] >= 0 && index[i] < KEYS;
+        }
+
+        if (lookupManyInHashTable(table, batch, count, found) != expectedFound) {
+            atomic_fetch_add(&errors, 1);
+        }
+        for (int i = 0; i < count; i++) {
+            Element expected = index[i] >= 0 && index[i] < KEYS ? &values[index[i]] : NULL;
+            if (found[i] != expected) {
+                atomic_fetch_add(&errors, 1);
+            }
+        }
+        // One-at-a-time lookups must agree with the batch
+        if (lookupInHashTable(table, batch[0]) != found[0]) {
+            atomic_fetch_add(&errors, 1);
+        }
+    }
+    return NULL;
+}
+
+
+int main(void) {
+    for (int i = 0; i < 2 * KEYS; i++) {
+        sprintf(keys[i], "id%d", i);
+    }
+
+    tables[0] = createFilledTable(HASH_BACKEND_CHAINED);
+    tables[1] = createFilledTable(HASH_BACKEND_OPEN);
+    tables[2] = createFilledTable(HASH_BACKEND_OPEN);
+    tables[3] = createFilledTable(HASH_BACKEND_CHAINED);
+    if (tables[0] == NULL || tables[1] == NULL || tables[2] == NULL || tables[3] == NULL
+        || freezeHashTable(tables[2]) == failure || enableHashTableFilter(tables[3]) == failure) {
+        printf("BatchedLookupStress: could not create the tables\n");
+        return 1;
+    }
+
+    pthread_t threads[READERS];
+    for (int i = 0; i < READERS; i++) {
+        pthread_create(&threads[i], NULL, reader, (void*)(size_t)(i + 1));
+    }
+    for (int i = 0; i < READERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    for (int i = 0; i < TABLES; i++) {
+        destroyHashTable(tables[i]);
+    }
+
+    printf("BatchedLookupStress: %s\n", atomic_load(&errors) == 0 ? "OK" : "FAIL");
+    return atomic_load(&errors) == 0 ? 0 : 1;
+}
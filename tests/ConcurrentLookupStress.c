@@ -0,0 +1,119 @@
+//
+// Stress test for the lock-free lookups of concurrentHashTable: reader threads look keys up and visit their values
+// while writer threads keep removing, re-inserting and replacing the same keys, so entries are retired and
+// reclaimed under the readers all the time. Build it with -fsanitize=thread or -fsanitize=address (make check);
+// a lookup that touches a reclaimed entry shows up there as a race or a use after free.
+//
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../ConcurrentHashTable.h"
+#include "TestCallbacks.h"
+
+#define KEYS 512            // Few keys, so readers and writers keep meeting on the same entries
+#define READERS 4
+#define WRITERS 2
+#define OPERATIONS 100000   // Operations per thread
+
+// Every key has two possible values; the table only stores pointers to them, so a lookup result can always be read
+static int originalValues[KEYS];
+static int updatedValues[KEYS];
+
+static concurrentHashTable table;
+static atomic_int errors;
+
+
+/*
+ * isValueOf:
+ * Tells whether value is one of the two values key number `index` can have.
+ */
+static bool isValueOf(Element value, int index) {
+    return value == &originalValues[index] || value == &updatedValues[index];
+}
+
+static status checkVisited(Element value, Element index) {
+    if (!isValueOf(value, *(int*)index)) {
+        atomic_fetch_add(&errors, 1);
+    }
+    return success;
+}
+
+
+static void* reader(void* seed) {
+    unsigned int state = (unsigned int)(size_t)seed;
+    char key[16];
+    for (int i = 0; i < OPERATIONS; i++) {
+        int index = rand_r(&state) % KEYS;
+        sprintf(key, "k%d", index);
+        Element value = lookupInConcurrentHashTable(table, key);
+        if (value != NULL && !isValueOf(value, index)) {
+            atomic_fetch_add(&errors, 1);
+        }
+        visitInConcurrentHashTable(table, key, checkVisited, &index);
+    }
+    return NULL;
+}
+
+
+static void* writer(void* seed) {
+    unsigned int state = (unsigned int)(size_t)seed;
+    char key[16];
+    for (int i = 0; i < OPERATIONS; i++) {
+        int index = rand_r(&state) % KEYS;
+        sprintf(key, "k%d", index);
+        bool existed;
+        switch (rand_r(&state) % 3) {
+            case 0:
+                removeFromConcurrentHashTable(table, key);
+                break;
+            case 1:
+                insertIfAbsentInConcurrentHashTable(table, key, &originalValues[index], &existed);
+                break;
+            default:
+                upsertConcurrentHashTable(table, key, &updatedValues[index], &existed);
+                break;
+        }
+    }
+    return NULL;
+}
+
+
+int main(void) {
+    // A few stripes, so each one is resized and its old indexes retired while readers are in it
+    table = createConcurrentHashTable(copyKey, freeKey, keepValue, forgetValue, equalKeys, hashKey, 16, 4);
+    if (table == NULL) {
+        printf("ConcurrentLookupStress: could not create the table\n");
+        return 1;
+    }
+
+    pthread_t threads[READERS + WRITERS];
+    for (int i = 0; i < READERS + WRITERS; i++) {
+        pthread_create(&threads[i], NULL, i < READERS ? reader : writer, (void*)(size_t)(i + 1));
+    }
+    for (int i = 0; i < READERS + WRITERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    // Once the threads are done, the count must match what the lookups find
+    int found = 0;
+    char key[16];
+    for (int i = 0; i < KEYS; i++) {
+        sprintf(key, "k%d", i);
+        Element value = lookupInConcurrentHashTable(table, key);
+        if (value != NULL) {
+            found++;
+            if (!isValueOf(value, i)) {
+                atomic_fetch_add(&errors, 1);
+            }
+        }
+    }
+    if (found != concurrentHashTableCount(table)) {
+        atomic_fetch_add(&errors, 1);
+    }
+    destroyConcurrentHashTable(table);
+
+    printf("ConcurrentLookupStress: %s\n", atomic_load(&errors) == 0 ? "OK" : "FAIL");
+    return atomic_load(&errors) == 0 ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+//
+// Stress test for the writers of concurrentHashTable. First every thread adds, inserts-if-absent, upserts and
+// removes keys of its own while the others do the same, so all stripes are shared and keep resizing; each result
+// must agree with what the thread knows its keys hold, and the final count with all of them together. Then all
+// threads race to insert the same keys with insertIfAbsentInConcurrentHashTable, and exactly one must win each key.
+// Build it with -fsanitize=thread or -fsanitize=address (make check).
+//
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../ConcurrentHashTable.h"
+#include "TestCallbacks.h"
+
+#define THREADS 4
+#define KEYS_PER_THREAD 2048
+#define OPERATIONS 100000   // Operations per thread in the first part
+#define RACE_KEYS 2000      // Keys every thread tries to insert in the second part
+
+static concurrentHashTable table;
+static int values[THREADS][KEYS_PER_THREAD][2];  // The two values each key of the first part can have
+static int present[THREADS];                     // Keys each thread left in the table
+static int racers[THREADS];                      // The value each thread inserts in the second part
+static atomic_int winners[RACE_KEYS];            // Threads that inserted each race key
+static atomic_int winner[RACE_KEYS];             // The last of them
+static pthread_barrier_t start;
+static atomic_int errors;
+
+
+/*
+ * churnOwnKeys:
+ * The first part for one thread: random writes to its own keys, each checked against the value the key should
+ * have (expected[i], NULL while absent). Returns the number of keys left in the table.
+ */
+static int churnOwnKeys(int thread, unsigned int* state) {
+    int* expected[KEYS_PER_THREAD] = {NULL};
+    int count = 0;
+    char key[24];
+    bool existed;
+
+    for (int op = 0; op < OPERATIONS; op++) {
+        int i = rand_r(state) % KEYS_PER_THREAD;
+        sprintf(key, "t%d-%d", thread, i);
+        int* first = &values[thread][i][0];
+        int* second = &values[thread][i][1];
+
+        switch (rand_r(state) % 4) {
+            case 0:
+                // A plain add does not look for the key, so only add keys known to be absent
+                if (expected[i] == NULL) {
+                    if (addToConcurrentHashTable(table, key, first) == failure) {
+                        atomic_fetch_add(&errors, 1);
+                    }
+                    expected[i] = first;
+                    count++;
+                }
+                break;
+            case 1:
+                if (insertIfAbsentInConcurrentHashTable(table, key, first, &existed) == failure
+                    || existed != (expected[i] != NULL)) {
+                    atomic_fetch_add(&errors, 1);
+                }
+                if (expected[i] == NULL) {
+                    expected[i] = first;
+                    count++;
+                }
+                break;
+            case 2:
+                if (upsertConcurrentHashTable(table, key, second, &existed) == failure
+                    || existed != (expected[i] != NULL)) {
+                    atomic_fetch_add(&errors, 1);
+                }
+                if (expected[i] == NULL) {
+                    count++;
+                }
+                expected[i] = second;
+                break;
+            default:
+                if ((removeFromConcurrentHashTable(table, key) == success) != (expected[i] != NULL)) {
+                    atomic_fetch_add(&errors, 1);
+                }
+                if (expected[i] != NULL) {
+                    expected[i] = NULL;
+                    count--;
+                }
+                break;
+        }
+        if (lookupInConcurrentHashTable(table, key) != (Element)expected[i]) {
+            atomic_fetch_add(&errors, 1);
+        }
+    }
+
+    // The other threads never touch these keys, so they must still hold what this thread left in them
+    for (int i = 0; i < KEYS_PER_THREAD; i++) {
+        sprintf(key, "t%d-%d", thread, i);
+        if (lookupInConcurrentHashTable(table, key) != (Element)expected[i]) {
+            atomic_fetch_add(&errors, 1);
+        }
+    }
+    return count;
+}
+
+
+/*
+ * raceForKeys:
+ * The second part for one thread: try to insert every race key, counting the keys this thread won.
+ */
+static void raceForKeys(int thread) {
+    char key[24];
+    bool existed;
+    for (int i = 0; i < RACE_KEYS; i++) {
+        sprintf(key, "race-%d", i);
+        if (insertIfAbsentInConcurrentHashTable(table, key, &racers[thread], &existed) == failure) {
+            atomic_fetch_add(&errors, 1);
+        } else if (!existed) {
+            atomic_fetch_add(&winners[i], 1);
+            atomic_store(&winner[i], thread);
+        }
+    }
+}
+
+
+static void* worker(void* id) {
+    int thread = (int)(size_t)id;
+    unsigned int state = (unsigned int)thread + 1;
+    pthread_barrier_wait(&start);
+    present[thread] = churnOwnKeys(thread, &state);
+    pthread_barrier_wait(&start);
+    raceForKeys(thread);
+    return NULL;
+}
+
+
+int main(void) {
+    // Few stripes and a small start, so the stripes are shared by all threads and resize over and over
+    table = createConcurrentHashTable(copyKey, freeKey, keepValue, forgetValue, equalKeys, hashKey, 16, 8);
+    if (table == NULL) {
+        printf("ConcurrentTableStress: could not create the table\n");
+        return 1;
+    }
+    pthread_barrier_init(&start, NULL, THREADS);
+
+    pthread_t threads[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+        pthread_create(&threads[i], NULL, worker, (void*)(size_t)i);
+    }
+    for (int i = 0; i < THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_barrier_destroy(&start);
+
+    // Every race key has exactly one winner, and the winner's value
+    int expectedCount = RACE_KEYS;
+    char key[24];
+    for (int i = 0; i < RACE_KEYS; i++) {
+        sprintf(key, "race-%d", i);
+        Element value = lookupInConcurrentHashTable(table, key);
+        if (atomic_load(&winners[i]) != 1 || value != (Element)&racers[atomic_load(&winner[i])]) {
+            atomic_fetch_add(&errors, 1);
+        }
+    }
+    for (int i = 0; i < THREADS; i++) {
+        expectedCount += present[i];
+    }
+    if (concurrentHashTableCount(table) != expectedCount) {
+        atomic_fetch_add(&errors, 1);
+    }
+    destroyConcurrentHashTable(table);
+
+    printf("ConcurrentTableStress: %s\n", atomic_load(&errors) == 0 ? "OK" : "FAIL");
+    return atomic_load(&errors) == 0 ? 0 : 1;
+}
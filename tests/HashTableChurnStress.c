@@ -0,0 +1,158 @@
+//
+// Stress test for the hashTable backends and their incremental resizing, keyed with hashString. Each thread churns
+// its own table (open addressing or chained, alternately) through phases that mostly add and phases that mostly
+// remove, so the table keeps growing and shrinking and most operations meet a migration half done. Every result
+// is checked against a plain array of what the table should hold. The threads share only hashString and its seed,
+// which must be safe to use from all of them at once. Build it with -fsanitize=thread or -fsanitize=address
+// (make check).
+//
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../HashTable.h"
+#include "TestCallbacks.h"
+
+#define THREADS 4
+#define KEYS 4096           // Keys each thread works with
+#define OPERATIONS 200000   // Operations per thread
+#define PHASE 20000         // Operations before a thread switches between mostly adding and mostly removing
+#define CHECK_EVERY 5000    // Operations between full checks of the table
+
+static atomic_int errors;
+
+
+/*
+ * makeKey:
+ * Writes key number i in the style of the Jerry IDs (digits and letters); pairs of keys are anagrams of each
+ * other, the case a character-sum hash maps to one bucket.
+ */
+static void makeKey(char* key, int i) {
+    int half = i / 2;
+    char a = (char)('0' + half % 10), b = (char)('0' + half / 10 % 10);
+    char c = (char)('a' + half / 100 % 26), d = (char)('A' + half / 2600 % 26);
+    if (i % 2 == 0) {
+        sprintf(key, "%c%c%c%c%d", a, b, c, d, half);
+    } else {
+        sprintf(key, "%c%c%c%c%d", b, a, d, c, half);
+    }
+}
+
+
+/*
+ * checkTable:
+ * Compares the whole table (count, iteration and a lookup of every key) with the expected values.
+ */
+static void checkTable(hashTable table, int* const* expected, int present, char keys[][16]) {
+    if (hashTableCount(table) != present) {
+        atomic_fetch_add(&errors, 1);
+    }
+    int visited = 0;
+    for (HashTableIterator it = hashTableBegin(table); hashTableIteratorValid(&it); hashTableIteratorNext(&it)) {
+        visited++;
+    }
+    if (visited != present) {
+        atomic_fetch_add(&errors, 1);
+    }
+    for (int i = 0; i < KEYS; i++) {
+        if (lookupInHashTable(table, keys[i]) != (Element)expected[i]) {
+            atomic_fetch_add(&errors, 1);
+        }
+    }
+}
+
+
+static void* churn(void* seed) {
+    unsigned int state = (unsigned int)(size_t)seed;
+    HashBackend backend = state % 2 ? HASH_BACKEND_OPEN : HASH_BACKEND_CHAINED;
+    int* values = (int*)calloc(2 * KEYS, sizeof(int));   // Two possible values per key
+    int** expected = (int**)calloc(KEYS, sizeof(int*));   // The value each key should have, or NULL
+    char (*keys)[16] = malloc(KEYS * sizeof(*keys));
+    hashTable table = createHashTableWithBackend(copyKey, freeKey, printElement, keepValue, forgetValue,
+                                                 printElement, equalKeys, hashString, 16, backend);
+    if (values == NULL || expected == NULL || keys == NULL || table == NULL) {
+        atomic_fetch_add(&errors, 1);
+        free(values);
+        free(expected);
+        free(keys);
+        destroyHashTable(table);
+        return NULL;
+    }
+    for (int i = 0; i < KEYS; i++) {
+        makeKey(keys[i], i);
+    }
+
+    int present = 0;
+    for (int op = 0; op < OPERATIONS; op++) {
+        int i = rand_r(&state) % KEYS;
+        bool adding = (op / PHASE) % 2 == 0;
+        int choice = rand_r(&state) % 10;
+        bool existed;
+
+        if (choice < 6) {
+            // Mostly adds while growing and mostly removes while shrinking
+            if (adding == (expected[i] == NULL)) {
+                if (adding) {
+                    if (addToHashTable(table, keys[i], &values[2 * i]) == failure) {
+                        atomic_fetch_add(&errors, 1);
+                    }
+                    expected[i] = &values[2 * i];
+                    present++;
+                } else {
+                    if (removeFromHashTable(table, keys[i]) == failure) {
+                        atomic_fetch_add(&errors, 1);
+                    }
+                    expected[i] = NULL;
+                    present--;
+                }
+            }
+        } else if (choice < 8 && (adding || expected[i] != NULL)) {
+            // While shrinking, upserts only replace values
+            if (upsertHashTable(table, keys[i], &values[2 * i + 1], &existed) == failure
+                || existed != (expected[i] != NULL)) {
+                atomic_fetch_add(&errors, 1);
+            }
+            if (expected[i] == NULL) {
+                present++;
+            }
+            expected[i] = &values[2 * i + 1];
+        } else if (choice < 9) {
+            // A remove of an absent key must fail and change nothing
+            if ((removeFromHashTable(table, keys[i]) == success) != (expected[i] != NULL)) {
+                atomic_fetch_add(&errors, 1);
+            }
+            if (expected[i] != NULL) {
+                expected[i] = NULL;
+                present--;
+            }
+        } else if (lookupInHashTable(table, keys[i]) != (Element)expected[i]) {
+            atomic_fetch_add(&errors, 1);
+        }
+
+        if (op % CHECK_EVERY == 0) {
+            checkTable(table, expected, present, keys);
+        }
+    }
+    checkTable(table, expected, present, keys);
+
+    destroyHashTable(table);
+    free(values);
+    free(expected);
+    free(keys);
+    return NULL;
+}
+
+
+int main(void) {
+    pthread_t threads[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+        pthread_create(&threads[i], NULL, churn, (void*)(size_t)(i + 1));
+    }
+    for (int i = 0; i < THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    printf("HashTableChurnStress: %s\n", atomic_load(&errors) == 0 ? "OK" : "FAIL");
+    return atomic_load(&errors) == 0 ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+//
+// Stress test for MpscQueue: several producer threads push numbered messages while the consumer pops and drains
+// them in batches at the same time. Every message must arrive exactly once, and the messages of each producer
+// in the order it pushed them. Build it with -fsanitize=thread or -fsanitize=address (make check); a push that
+// publishes its node too early shows up there as a race, a lost or freed node as a use after free or a leak.
+//
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../MpscQueue.h"
+
+#define PRODUCERS 4
+#define MESSAGES 100000 // Messages per producer
+#define BATCH 64        // Largest batch the consumer drains at once
+#define LEFT_OVER 1000  // Messages left in the queue for destroyMpscQueue to free
+
+// One message: who pushed it and its place in that producer's sequence
+typedef struct Message {
+    int producer;
+    int sequence;
+} Message;
+
+// What the consumer has seen so far
+typedef struct Consumer_State {
+    int next[PRODUCERS]; // The sequence number expected next from each producer
+    int received;        // Messages taken so far
+    int errors;          // Messages out of order, from an unknown producer, or seen twice
+} ConsumerState;
+
+static MpscQueue queue;
+static atomic_int pushFailures;
+
+
+static status freeMessage(Element element) {
+    free(element);
+    return success;
+}
+
+
+/*
+ * receive:
+ * Checks that a message is the next one of its producer, then frees it (the consumer owns what it takes).
+ */
+static status receive(Element element, Element context) {
+    Message* message = (Message*)element;
+    ConsumerState* state = (ConsumerState*)context;
+    if (message->producer < 0 || message->producer >= PRODUCERS
+        || message->sequence != state->next[message->producer]) {
+        state->errors++;
+    } else {
+        state->next[message->producer]++;
+    }
+    state->received++;
+    free(message);
+    return success;
+}
+
+
+static void* producer(void* id) {
+    for (int i = 0; i < MESSAGES; i++) {
+        Message* message = (Message*)malloc(sizeof(Message));
+        if (message == NULL) {
+            atomic_fetch_add(&pushFailures, 1);
+            continue;
+        }
+        message->producer = (int)(size_t)id;
+        message->sequence = i;
+        if (pushToMpscQueue(queue, message) == failure) {
+            free(message);
+            atomic_fetch_add(&pushFailures, 1);
+        }
+    }
+    return NULL;
+}
+
+
+int main(void) {
+    queue = createMpscQueue(freeMessage);
+    if (queue == NULL) {
+        printf("MpscQueueStress: could not create the queue\n");
+        return 1;
+    }
+
+    pthread_t threads[PRODUCERS];
+    for (int i = 0; i < PRODUCERS; i++) {
+        pthread_create(&threads[i], NULL, producer, (void*)(size_t)i);
+    }
+
+    // Alternate single pops and batched drains until every message has arrived
+    ConsumerState state = {{0}, 0, 0};
+    bool popNext = true;
+    while (state.received < PRODUCERS * MESSAGES && atomic_load(&pushFailures) == 0) {
+        if (popNext) {
+            Element element = popFromMpscQueue(queue);
+            if (element != NULL) {
+                receive(element, &state);
+            }
+        } else if (drainMpscQueue(queue, receive, &state, BATCH) < 0) {
+            state.errors++;
+            break;
+        }
+        popNext = !popNext;
+    }
+    for (int i = 0; i < PRODUCERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    // Nothing may be left once all the messages came through
+    if (popFromMpscQueue(queue) != NULL) {
+        state.errors++;
+    }
+    for (int i = 0; i < PRODUCERS; i++) {
+        if (state.next[i] != MESSAGES) {
+            state.errors++;
+        }
+    }
+
+    // Leave some messages behind; destroying the queue must free them (a leak shows up under AddressSanitizer)
+    for (int i = 0; i < LEFT_OVER; i++) {
+        Message* message = (Message*)malloc(sizeof(Message));
+        if (message == NULL || pushToMpscQueue(queue, message) == failure) {
+            free(message);
+            state.errors++;
+        }
+    }
+    destroyMpscQueue(queue);
+
+    bool passed = state.errors == 0 && atomic_load(&pushFailures) == 0;
+    printf("MpscQueueStress: %s\n", passed ? "OK" : "FAIL");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+//
+// Callbacks the stress tests hand to the tables: keys are strings the table copies and frees, values point into
+// arrays owned by the test, so the table neither copies nor frees them.
+//
+
+#ifndef TESTCALLBACKS_H
+#define TESTCALLBACKS_H
+#include <string.h>
+#include "../Defs.h"
+
+static inline Element copyKey(Element key) {
+    return strdup((char*)key);
+}
+
+static inline status freeKey(Element key) {
+    free(key);
+    return success;
+}
+
+static inline bool equalKeys(Element first, Element second) {
+    return strcmp((char*)first, (char*)second) == 0;
+}
+
+// FNV-1a, for the tests that do not link HashTable.c (and its hashString)
+static inline int hashKey(Element key) {
+    unsigned int hash = 2166136261u;
+    for (const char* c = (const char*)key; *c; c++) {
+        hash = (hash ^ (unsigned char)*c) * 16777619u;
+    }
+    return (int)(hash & 0x7fffffff);
+}
+
+static inline Element keepValue(Element value) {
+    return value;
+}
+
+static inline status forgetValue(Element value) {
+    (void)value;
+    return success;
+}
+
+// The tables are never displayed
+static inline status printElement(Element element) {
+    (void)element;
+    return success;
+}
+
+#endif //TESTCALLBACKS_H